@@ -2,12 +2,13 @@ import matplotlib.pyplot as plt
 import numpy as np
 import subprocess
 import os
-from tqdm import tqdm
+import csv
+import io
 
 
 cur_dir = os.path.dirname(os.path.abspath(__file__))
 
-exec_file = "/build/bin/lmeca2710_project"
+exec_file = "build/bin/delaunay_benchmark"
 
 gl_timing = np.loadtxt(os.path.join(cur_dir, "static/gilles_and_louis_timing.txt"))
 je_timing = np.loadtxt(os.path.join(cur_dir, "static/jerome_timing.txt"))
@@ -15,22 +16,24 @@ je_timing = np.loadtxt(os.path.join(cur_dir, "static/jerome_timing.txt"))
 
 if __name__ == "__main__":
 
-    ns = np.logspace(2, 6, num=50, dtype=int)
-    ts = np.zeros_like(ns, dtype=float)
+    # The benchmark runs in-process, timing each phase with a monotonic clock
+    args = [os.path.join(cur_dir, exec_file), "-s", "100:1000000:50", "-p", "normal", "-r", "11", "-f", "csv"]
 
-    args = ["." + os.path.join(cur_dir, exec_file)]
+    process = subprocess.run(args, stdout=subprocess.PIPE, check=True)
+    rows = [row for row in csv.DictReader(io.StringIO(process.stdout.decode()))
+            if row["phase"] == "total"]
 
-    for i, n in tqdm(enumerate(ns), total=ns.size):
-        process = subprocess.Popen(args + ["-x", str(n)], stdout=subprocess.PIPE)
-        process.wait()
-        stdout = process.communicate()[0]
-        ts[i] = float(stdout.decode().strip())
+    ns = np.array([int(row["n_points"]) for row in rows])
+    ts = np.array([float(row["median_us"]) for row in rows])
+    ts_low = np.array([float(row["p10_us"]) for row in rows])
+    ts_high = np.array([float(row["p90_us"]) for row in rows])
 
     plt.loglog(je_timing[:, 0], je_timing[:, 1], label=r"Divide and conquer (on my pc)")
     plt.loglog(ns, ns * np.log(ns), label=r"$n\log(n)$")
     plt.loglog(ns, ns, label=r"$n$")
     plt.loglog(gl_timing[:, 0], gl_timing[:, 1], label=r"Fortune's algo. from Gilles and Louis (on my pc)")
-    plt.loglog(ns, ts, "--", label=r"Divide and conquer (on your pc)")
+    plt.loglog(ns, ts, "--", label=r"Divide and conquer (on your pc, median)")
+    plt.fill_between(ns, ts_low, ts_high, alpha=0.3, label=r"10th to 90th percentiles")
 
     plt.legend()
 
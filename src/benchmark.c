@@ -0,0 +1,457 @@
+/*
+ * Benchmark of the Delaunay triangulation program, without any drawing.
+ *
+ * Author: 	Jerome Eertmans
+ * Context: project for the LMECA2710 course, at EPL faculty UCLouvain,
+ *			given by Pr. Vincent Legat and Pr. Jean-Francois Remacle.
+ *
+ * All sources of inspiration are clearly marked at specific places in the code.
+ * Feel free to use and re-use this code! No attribution but the ones for BOV.h,
+ * predicates.h and the sound files are required.
+ *
+ * Any contribution is welcome on the Github this project:
+ * https://github.com/jeertmans/DelaunayTriangulation
+ */
+
+#include "inputs.h"
+#include "delaunay.h"
+#include <time.h>
+#include <getopt.h>
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+#define OPTSTR "s:p:c:l:m:r:w:j:e:f:o:h"
+#define USAGE_FMT  "\
+Delaunay Triangulation benchmark.\n\n\
+Usage:\n\
+\t./%s [options] [...]\n\
+\t./%s -s 100:1000000:50 -p uniform,normal -r 21 -f csv -o timing.csv\n\
+\t./%s -p uniform,corridor -c x,alternating\n\
+\t./%s -s 10000,1000000 -l 3,8,16,24,32,48,64\n\
+\n\
+Each phase is timed separately with a monotonic clock, for every size and random process:\n\
+\talloc         initDelaunayTriangulation (copy of the points)\n\
+\tsort          sortPoints, then arrangePoints with alternating cuts (preparePoints)\n\
+\ttriangulate   triangulateDT, or triangulateDTParallel with more than one thread\n\
+\textract       getDelaunayTriangulationLines\n\
+\ttotal         all of the above\n\
+\n\
+Options:\n\
+\t[-s sizes=1000,10000,100000,1000000]\n\
+\t                              comma separated numbers of points, or min:max:count for count log-spaced sizes\n\
+\t[-p random_processes=uniform,normal]\n\
+\t                              comma separated among normal, uniform, uniform-circle, polygon and corridor\n\
+\t                              (uniform points in a band 100 times taller than wide)\n\
+\t[-c cuts=x]                   comma separated among x and alternating, how triangulateDT divides the points\n\
+\t[-l leaf_sizes=%d]            comma separated sizes of the leaves of the divide and conquer (3 to %d),\n\
+\t                              or min:max:count as for the sizes, see triangulateLeaf\n\
+\t[-m smoothing_factor=4]       smoothing applied on random polygon\n\
+\t[-r repetitions=11]           timed repetitions of each case\n\
+\t[-w warmups=1]                untimed repetitions before them\n\
+\t[-j number_of_threads=1]      number of threads used by the triangulation, 0 to use all available threads\n\
+\t[-e seed=1]                   seed of rand(), points are generated again with this seed for every case\n\
+\t[-f format=csv]               csv or json\n\
+\t[-o output_file=stdout]       file where the timings are written\n\
+\t[-h]                          displays help and exits\n"
+#define DEFAULT_PROGNAME "delaunay_benchmark"
+
+#define BENCHMARK_MAX_SIZES 256		// Maximum number of sizes in a sweep
+#define BENCHMARK_PHASES 5
+#define BENCHMARK_MAX_CUTS 8		// Maximum number of cuts compared
+
+typedef struct options_t {
+	char *s;
+	char *p;
+	char *c;
+	char *l;
+	int m;
+	int r;
+	int w;
+	int j;
+	int e;
+	char *f;
+	char *o;
+} options_t;
+
+static const char *phase_names[BENCHMARK_PHASES] = {"alloc", "sort", "triangulate", "extract", "total"};
+static const char *cuts_names[2] = {"x", "alternating"};	// indexed by X_CUTS and ALTERNATING_CUTS
+
+
+void usage(char *progname);
+
+/*
+ * Returns the time elapsed since an arbitrary origin, from a monotonic clock.
+ *
+ * returns:		the time in seconds
+ */
+double getMonotonicTime() {
+#ifdef _WIN32
+	LARGE_INTEGER count, frequency;
+	QueryPerformanceCounter(&count);
+	QueryPerformanceFrequency(&frequency);
+	return (double) count.QuadPart / (double) frequency.QuadPart;
+#else
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (double) t.tv_sec + 1e-9 * (double) t.tv_nsec;
+#endif
+}
+
+static int compare_times(const void *a_v, const void *b_v) {
+	double a = *(const double*) a_v;
+	double b = *(const double*) b_v;
+	return (a > b) - (a < b);
+}
+
+/*
+ * Returns a percentile of sorted timings, interpolated linearly between
+ * the two closest ranks.
+ *
+ * times:		the n sorted timings
+ * n:			the number of timings
+ * q:			the percentile, between 0 and 100
+ *
+ * returns:		the percentile
+ */
+double getPercentile(double times[], int n, double q) {
+	double rank = q / 100.0 * (n - 1);
+	int i = (int) rank;
+	if (i >= n - 1) return times[n - 1];
+	return times[i] + (rank - i) * (times[i + 1] - times[i]);
+}
+
+/*
+ * Parses the sizes of a sweep, either as a comma separated list or as
+ * min:max:count (count sizes, log-spaced between min and max).
+ *
+ * str:			the string to parse
+ * sizes:		the array of at most BENCHMARK_MAX_SIZES sizes to fill
+ *
+ * returns:		the number of sizes, 0 if the string could not be parsed
+ */
+int parseSizes(char *str, DTsize sizes[]) {
+	double a, b;
+	int count;
+	if (sscanf(str, "%lf:%lf:%d", &a, &b, &count) == 3) {
+		if ((a < 1) || (b < a) || (count < 1) || (count > BENCHMARK_MAX_SIZES)) return 0;
+		for (int i = 0; i < count; i++) {
+			double t = (count == 1) ? 0.0 : (double) i / (count - 1);
+			sizes[i] = (DTsize) (a * pow(b / a, t));
+		}
+		return count;
+	}
+
+	count = 0;
+	char *end;
+	while (*str != '\0') {
+		long n = strtol(str, &end, 10);
+		if ((end == str) || (n < 1) || (count == BENCHMARK_MAX_SIZES)) return 0;
+		sizes[count++] = (DTsize) n;
+		str = (*end == ',') ? end + 1 : end;
+	}
+	return count;
+}
+
+/*
+ * Generates random points with one of the processes of inputs.h.
+ *
+ * process:		the name of the random process
+ * points:		the n x 2 array to fill
+ * n:			the number of points
+ * smoothing:	the smoothing factor of the random polygon
+ *
+ * returns:		1 if the process exists, 0 otherwise
+ */
+int generatePoints(char *process, DTfloat points[][2], DTsize n, int smoothing) {
+	float (*random)[2] = malloc(sizeof(random[0]) * n);
+	if (random == NULL) {
+		printf("ERROR: Could not allocate %d random points\n", n);
+		exit(EXIT_FAILURE);
+	}
+	float min[2] = {0.0, 0.0};
+	float max[2] = {1.0, 1.0};
+
+	if (strcmp(process, "normal") == 0) {
+		random_points(random, n);
+	}
+	else if (strcmp(process, "uniform") == 0) {
+		random_uniform_points(random, n, min, max);
+	}
+	else if (strcmp(process, "uniform-circle") == 0) {
+		random_uniform_points_in_circle(random, n, min, max);
+	}
+	else if (strcmp(process, "polygon") == 0) {
+		random_polygon(random, n, smoothing);
+	}
+	else if (strcmp(process, "corridor") == 0) {
+		float band[2] = {0.01, 1.0};
+		random_uniform_points(random, n, min, band);
+	}
+	else {
+		free(random);
+		return 0;
+	}
+
+	for (DTsize i = 0; i < n; i++) {
+		points[i][0] = random[i][0];
+		points[i][1] = random[i][1];
+	}
+	free(random);
+	return 1;
+}
+
+/*
+ * Triangulates a set of points once, timing each phase separately.
+ *
+ * points:		the n x 2 array of points
+ * n:			the number of points
+ * n_threads:	the number of threads, as for triangulateDTParallel
+ * cuts:		X_CUTS or ALTERNATING_CUTS (see triangulateDT)
+ * leaf_size:	the size of the leaves of the divide and conquer (see triangulateLeaf)
+ * times:		the array of BENCHMARK_PHASES timings to fill, in seconds
+ *
+ * returns:		1 if the triangulation was computed, 0 otherwise
+ */
+int benchmarkTriangulation(DTfloat points[][2], DTsize n, int n_threads, int cuts, DTsize leaf_size, double times[]) {
+	double t0 = getMonotonicTime();
+	DelaunayTriangulation *delTri = initDelaunayTriangulation(points, n, 0);
+	if (delTri == NULL) {
+		printf("ERROR: Could not initialize the triangulation of %d points\n", n);
+		return 0;
+	}
+	delTri->cuts = cuts;
+	delTri->leaf_size = leaf_size;
+	double t1 = getMonotonicTime();
+
+	// Same number of threads as the sort done by triangulateDT(Parallel)
+	if (!preparePoints(delTri, (n_threads == 1) ? 0 : n_threads)) {
+		freeDelaunayTriangulation(delTri);
+		return 0;
+	}
+	double t2 = getMonotonicTime();
+
+	int success = (n_threads == 1) ? triangulateDT(delTri) : triangulateDTParallel(delTri, n_threads, 0);
+	double t3 = getMonotonicTime();
+
+	DTsize n_lines = getDelaunayTriangulationNumberOfLines(delTri);
+	float (*lines)[2] = malloc(sizeof(lines[0]) * 2 * n_lines);
+	if (lines == NULL) {
+		printf("ERROR: Could not allocate %d lines\n", n_lines);
+		freeDelaunayTriangulation(delTri);
+		return 0;
+	}
+	getDelaunayTriangulationLines(delTri, lines, n_lines);
+	double t4 = getMonotonicTime();
+
+	free(lines);
+	freeDelaunayTriangulation(delTri);
+
+	times[0] = t1 - t0;
+	times[1] = t2 - t1;
+	times[2] = t3 - t2;
+	times[3] = t4 - t3;
+	times[4] = t4 - t0;
+	return success;
+}
+
+int main(int argc, char *argv[])
+{
+	int opt;
+	options_t options = {	// Default values
+		"1000,10000,100000,1000000",	// Sizes
+		"uniform,normal",	// Random processes
+		"x",		// Cuts
+		NULL,		// Leaf sizes, DEFAULT_LEAF_SIZE
+		4,			// Smoothing factor
+		11,			// Repetitions
+		1,			// Warmups
+		1,			// Sequential triangulation
+		1,			// Seed
+		"csv",		// Output format
+		NULL,		// Output file
+	};
+
+	while ((opt = getopt(argc, argv, OPTSTR)) != EOF) {
+		switch(opt) {
+			case 's':
+				options.s = optarg;
+				break;
+			case 'p':
+				options.p = optarg;
+				break;
+			case 'c':
+				options.c = optarg;
+				break;
+			case 'l':
+				options.l = optarg;
+				break;
+			case 'm':
+				options.m = atoi(optarg);
+				break;
+			case 'r':
+				options.r = atoi(optarg);
+				break;
+			case 'w':
+				options.w = atoi(optarg);
+				break;
+			case 'j':
+				options.j = atoi(optarg);
+				break;
+			case 'e':
+				options.e = atoi(optarg);
+				break;
+			case 'f':
+				options.f = optarg;
+				break;
+			case 'o':
+				options.o = optarg;
+				break;
+			case 'h':
+			default:
+				usage(argv[0]);
+				/* NOTREACHED */
+				break;
+		}
+	}
+
+	DTsize sizes[BENCHMARK_MAX_SIZES];
+	int n_sizes = parseSizes(options.s, sizes);
+	if (n_sizes == 0) {
+		printf("ERROR: Could not parse sizes %s\n", options.s);
+		exit(EXIT_FAILURE);
+	}
+	if (options.r < 1) {
+		printf("ERROR: At least one repetition is needed\n");
+		exit(EXIT_FAILURE);
+	}
+	// strtok modifies the string, and the defaults are literals
+	int cuts[BENCHMARK_MAX_CUTS], n_cuts = 0;
+	char *cuts_list = strdup(options.c);
+	for (char *c = strtok(cuts_list, ","); c != NULL; c = strtok(NULL, ",")) {
+		if (strcmp(c, cuts_names[X_CUTS]) == 0) cuts[n_cuts] = X_CUTS;
+		else if (strcmp(c, cuts_names[ALTERNATING_CUTS]) == 0) cuts[n_cuts] = ALTERNATING_CUTS;
+		else {
+			printf("ERROR: Unknown cuts %s, please choose x or alternating\n", c);
+			exit(EXIT_FAILURE);
+		}
+		if (++n_cuts == BENCHMARK_MAX_CUTS) break;
+	}
+	free(cuts_list);
+	if (n_cuts == 0) {
+		printf("ERROR: Could not parse cuts %s\n", options.c);
+		exit(EXIT_FAILURE);
+	}
+	DTsize leaf_sizes[BENCHMARK_MAX_SIZES] = {DEFAULT_LEAF_SIZE};
+	int n_leaf_sizes = (options.l == NULL) ? 1 : parseSizes(options.l, leaf_sizes);
+	for (int k = 0; k < n_leaf_sizes; k++) {
+		if ((leaf_sizes[k] < 3) || (leaf_sizes[k] > LEAF_SIZE_MAX)) n_leaf_sizes = 0;
+	}
+	if (n_leaf_sizes == 0) {
+		printf("ERROR: Could not parse leaf sizes %s, they must be between 3 and %d\n", options.l, LEAF_SIZE_MAX);
+		exit(EXIT_FAILURE);
+	}
+	int json = (strcmp(options.f, "json") == 0);
+	if (!json && (strcmp(options.f, "csv") != 0)) {
+		printf("ERROR: Unknown format %s, please choose csv or json\n", options.f);
+		exit(EXIT_FAILURE);
+	}
+
+	FILE *file_out = stdout;
+	if (options.o != NULL) {
+		file_out = fopen(options.o, "w");
+		if (file_out == NULL) {
+			printf("ERROR: Couldn't open file %s in write mode.\n", options.o);
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	if (json) fprintf(file_out, "[");
+	else fprintf(file_out, "process,n_points,n_threads,cuts,leaf_size,phase,repetitions,min_us,p10_us,median_us,p90_us,max_us\n");
+
+	double (*times)[BENCHMARK_PHASES] = malloc(sizeof(times[0]) * options.r);
+	double *phase_times = malloc(sizeof(phase_times[0]) * options.r);
+	if ((times == NULL) || (phase_times == NULL)) {
+		printf("ERROR: Could not allocate the timings of %d repetitions\n", options.r);
+		exit(EXIT_FAILURE);
+	}
+	int first = 1;
+
+	char *processes = strdup(options.p);
+	for (char *process = strtok(processes, ","); process != NULL; process = strtok(NULL, ",")) {
+		for (int k = 0; k < n_sizes; k++) {
+			DTsize n = sizes[k];
+			DTfloat (*points)[2] = malloc(sizeof(points[0]) * n);
+			if (points == NULL) {
+				printf("ERROR: Could not allocate %d points\n", n);
+				exit(EXIT_FAILURE);
+			}
+
+			srand(options.e);
+			if (!generatePoints(process, points, n, options.m)) {
+				printf("ERROR: Unknown random process: %s\n", process);
+				exit(EXIT_FAILURE);
+			}
+
+			// Every cuts, with every leaf size
+			for (int c = 0; c < n_cuts * n_leaf_sizes; c++) {
+				int cut = cuts[c / n_leaf_sizes];
+				DTsize leaf_size = leaf_sizes[c % n_leaf_sizes];
+
+				for (int r = -options.w; r < options.r; r++) {
+					double t[BENCHMARK_PHASES];
+					if (!benchmarkTriangulation(points, n, options.j, cut, leaf_size, t)) {
+						printf("ERROR: Triangulation of %d points (%s) failed\n", n, process);
+						exit(EXIT_FAILURE);
+					}
+					if (r >= 0) memcpy(times[r], t, sizeof(t));
+				}
+
+				for (int p = 0; p < BENCHMARK_PHASES; p++) {
+					for (int r = 0; r < options.r; r++) {
+						phase_times[r] = 1e6 * times[r][p];
+					}
+					qsort(phase_times, options.r, sizeof(phase_times[0]), compare_times);
+
+					double min = phase_times[0], max = phase_times[options.r - 1];
+					double p10 = getPercentile(phase_times, options.r, 10.0);
+					double median = getPercentile(phase_times, options.r, 50.0);
+					double p90 = getPercentile(phase_times, options.r, 90.0);
+
+					if (json) {
+						fprintf(file_out, "%s\n  {\"process\": \"%s\", \"n_points\": %d, \"n_threads\": %d, "
+								"\"cuts\": \"%s\", \"leaf_size\": %d, \"phase\": \"%s\", \"repetitions\": %d, \"min_us\": %.3f, "
+								"\"p10_us\": %.3f, \"median_us\": %.3f, \"p90_us\": %.3f, \"max_us\": %.3f}",
+								first ? "" : ",", process, n, options.j, cuts_names[cut], leaf_size, phase_names[p], options.r,
+								min, p10, median, p90, max);
+					}
+					else {
+						fprintf(file_out, "%s,%d,%d,%s,%d,%s,%d,%.3f,%.3f,%.3f,%.3f,%.3f\n",
+								process, n, options.j, cuts_names[cut], leaf_size, phase_names[p], options.r,
+								min, p10, median, p90, max);
+					}
+					first = 0;
+				}
+			}
+			fflush(file_out);
+			free(points);
+		}
+	}
+
+	if (json) fprintf(file_out, "\n]\n");
+
+	free(processes);
+	free(times);
+	free(phase_times);
+	if (file_out != stdout) fclose(file_out);
+
+	return EXIT_SUCCESS;
+}
+
+void usage(char *progname) {
+	progname = progname ? progname : DEFAULT_PROGNAME;
+	fprintf(stderr, USAGE_FMT, progname, progname, progname, progname, DEFAULT_LEAF_SIZE, LEAF_SIZE_MAX);
+	exit(EXIT_FAILURE);
+	/* NOTREACHED */
+}
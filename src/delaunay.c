@@ -30,28 +30,25 @@
  *
  * returns:					a new DelaunayTriangulation structure
  */
-DelaunayTriangulation* initDelaunayTriangulation(GLfloat points[][2], GLsizei n, int remove_duplicates) {
-
-#if ROBUST
-	exactinit();
-#endif
-
-    DelaunayTriangulation *delTri = malloc(sizeof(DelaunayTriangulation));
+DelaunayTriangulation* initDelaunayTriangulation(DTfloat points[][2], DTsize n, int remove_duplicates) {
 
     // Points
-    delTri->n_points = n;
-    delTri->points = malloc(sizeof(delTri->points[0]) * n);
+    DTfloat (*copy)[2] = malloc(sizeof(copy[0]) * n);
 
-	for (GLsizei i = 0; i < n; i++) {
-		delTri->points[i][0] = points[i][0];
-		delTri->points[i][1] = points[i][1];
+	for (DTsize i = 0; i < n; i++) {
+		copy[i][0] = points[i][0];
+		copy[i][1] = points[i][1];
 	}
 
+    DelaunayTriangulation *delTri = initDelaunayTriangulationInPlace(copy, n, 0);
+    delTri->points_owned = 1;
+
 	if ((remove_duplicates) && (delTri->n_points > 1)) {
-		qsort(delTri->points, delTri->n_points, 2 * sizeof(GLfloat), compare_points);
+		sortPoints(delTri->points, delTri->n_points, 0);
+		delTri->sorted = 1;
 
-		GLsizei c = 1;
-		for (GLsizei i = 1; i < delTri->n_points; i++) {
+		DTsize c = 1;
+		for (DTsize i = 1; i < delTri->n_points; i++) {
 			while ((delTri->points[i][0] == delTri->points[c - 1][0]) && (delTri->points[i][1] == delTri->points[c - 1][1])) {
 				if (i < delTri->n_points - 1) {
 					i++;
@@ -66,10 +63,10 @@ DelaunayTriangulation* initDelaunayTriangulation(GLfloat points[][2], GLsizei n,
 			c++;
 		}
 
-		GLfloat (*p)[2] = malloc(sizeof(delTri->points[0]) * c);
+		DTfloat (*p)[2] = malloc(sizeof(delTri->points[0]) * c);
 		if (p == NULL) printf("ERROR: Couldn't reallocate memory for points after removing duplicates\n");
 
-		for (GLsizei i = 0; i < c; i++) {
+		for (DTsize i = 0; i < c; i++) {
 			p[i][0] = delTri->points[i][0];
 			p[i][1] = delTri->points[i][1];
 		}
@@ -77,9 +74,66 @@ DelaunayTriangulation* initDelaunayTriangulation(GLfloat points[][2], GLsizei n,
 		free(delTri->points);
 		delTri->points = p;
 		delTri->n_points = c;
+		delTri->n_points_max = c;
 	}
 
-	delTri->edges = NULL;
+	return delTri;
+}
+
+/*
+ * Allocates and returns a DelaunayTriangulation structure that uses a set of
+ * n points without copying it (e.g. the points of a mapped point file). The
+ * array is not freed with the structure and must outlive it. It is modified
+ * when the points are sorted (unless they already are) or deleted, and it is
+ * only copied when points have to be added to a full array.
+ *
+ * points: 		the n x 2 array of distinct points (x, y)
+ * n:			the number of points
+ * sorted:		if set, the points are known to be sorted as sortPoints does
+ *
+ * returns:		a new DelaunayTriangulation structure
+ */
+DelaunayTriangulation* initDelaunayTriangulationInPlace(DTfloat points[][2], DTsize n, int sorted) {
+
+    DelaunayTriangulation *delTri = malloc(sizeof(DelaunayTriangulation));
+
+    // Points
+    delTri->n_points = n;
+    delTri->points = points;
+    delTri->points_owned = 0;
+    delTri->sorted = sorted;
+    delTri->cuts = X_CUTS;
+    delTri->arranged = 0;
+    delTri->leaf_size = DEFAULT_LEAF_SIZE;
+
+	delTri->n_points_max = delTri->n_points;
+	delTri->free_points = NULL;
+	delTri->n_free_points = 0;
+	delTri->n_free_points_max = 0;
+
+	delTri->grid_nx = delTri->grid_ny = 0;
+	delTri->grid_cells = delTri->grid_next = NULL;
+	delTri->grid_cells_max = delTri->grid_next_max = 0;
+
+	delTri->n_edge_chunks = 0;
+	delTri->n_edge_chunks_max = 0;
+	delTri->edge_chunks = NULL;
+#if COMPACT_EDGES
+	delTri->edge_flags = NULL;
+#endif
+	delTri->arenas = NULL;
+	delTri->edge_stack = NULL;
+	delTri->edge_stack_max = 0;
+
+	delTri->version = 1;
+	delTri->triangles_version = 0;
+	delTri->n_triangles = delTri->n_triangles_max = 0;
+	delTri->triangles = delTri->triangles_edges = delTri->triangles_neighbors = NULL;
+	delTri->edges_triangle = NULL;
+	delTri->edges_triangle_max = 0;
+#if DT_STATS
+	memset(&delTri->stats, 0, sizeof(delTri->stats));
+#endif
 	resetDelaunayTriangulation(delTri);
 
 	return delTri;
@@ -88,33 +142,204 @@ DelaunayTriangulation* initDelaunayTriangulation(GLfloat points[][2], GLsizei n,
 /*
  * Resets a DelaunayTriangulation so that a new triangulation can safely be done.
  * Must be run whenever you modify the points.
+ * Chunks of edges already allocated are kept and will be reused.
  *
  * delTri:		the DelaunayTriangulation structure
  */
 void resetDelaunayTriangulation(DelaunayTriangulation *delTri) {
-	if (delTri->edges != NULL) {
-		free(delTri->edges);
+	// (Half) Edges
+	delTri->n_edges = 0;
+	delTri->n_edges_discarded = 0;
+	delTri->n_edges_max = delTri->n_edge_chunks << EDGE_CHUNK_BITS;
+	delTri->free_edges = EDGE_NULL;
+	delTri->hint = EDGE_NULL;
+
+	delTri->success = 0;
+	delTri->version++;
+}
+
+/*
+ * Builds the uniform grid used to find the closest point, over the bounding
+ * box of the points, with about GRID_POINTS_PER_CELL points per cell.
+ *
+ * delTri:		the DelaunayTriangulation structure
+ *
+ * returns:		1 if the grid was built, 0 otherwise (no point or not enough memory)
+ */
+int buildPointGrid(DelaunayTriangulation *delTri) {
+	DTfloat bounds[2][2];
+	DTsize n = getDelaunayTriangulationNumberOfPoints(delTri);
+
+	delTri->grid_nx = delTri->grid_ny = 0;
+	if (n == 0) return 0;
+
+	getPointsBoudingBox(delTri->points, delTri->n_points, bounds);
+	double width = bounds[1][0] - bounds[0][0];
+	double height = bounds[1][1] - bounds[0][1];
+	double n_cells = MAX(n / GRID_POINTS_PER_CELL, 1);
+	double size = sqrt(width * height / n_cells);
+
+	// Points (almost) on a line
+	if (size < MAX(width, height) / n_cells) size = MAX(width, height) / n_cells;
+	if (size <= 0) size = 1;
+
+	DTsize nx = MIN((DTsize) (width / size) + 1, (DTsize) n_cells);
+	DTsize ny = MIN((DTsize) (height / size) + 1, (DTsize) n_cells);
+
+	if (nx * ny > delTri->grid_cells_max) {
+		DTsize *cells = realloc(delTri->grid_cells, sizeof(DTsize) * nx * ny);
+		if (cells == NULL) {
+			printf("ERROR: Couldn't allocate memory for the grid of points\n");
+			return 0;
+		}
+		delTri->grid_cells = cells;
+		delTri->grid_cells_max = nx * ny;
+	}
+	if (delTri->n_points_max > delTri->grid_next_max) {
+		DTsize *next = realloc(delTri->grid_next, sizeof(DTsize) * delTri->n_points_max);
+		if (next == NULL) {
+			printf("ERROR: Couldn't allocate memory for the grid of points\n");
+			return 0;
+		}
+		delTri->grid_next = next;
+		delTri->grid_next_max = delTri->n_points_max;
 	}
 
-	// (Half) Edges
-	if (delTri->n_points == 0) {
-		delTri->n_edges_max = 0;
+	for (DTsize i = 0; i < nx * ny; i++) {
+		delTri->grid_cells[i] = -1;
 	}
-	else {
-		delTri->n_edges_max = (GLsizei) ceil((log(delTri->n_points) * 3 * delTri->n_points));
+	delTri->grid_min[0] = bounds[0][0];
+	delTri->grid_min[1] = bounds[0][1];
+	delTri->grid_inv_size = 1 / size;
+	delTri->grid_n_points = 0;
+	delTri->grid_n_outside = 0;
+	delTri->grid_nx = nx;
+	delTri->grid_ny = ny;
+
+	for (DTsize i = 0; i < delTri->n_points; i++) {
+		if (!POINT_DELETED(delTri, i)) {
+			addPointToGrid(delTri, i);
+		}
 	}
+	return 1;
+}
 
-	delTri->n_edges = 0;
-	delTri->n_edges_discarded = 0;
-	delTri->edges = malloc(sizeof(Edge) * delTri->n_edges_max);
+/*
+ * Finds the cell of the grid containing a point. Points outside the grid
+ * are put in the closest cell.
+ *
+ * delTri:		the DelaunayTriangulation structure
+ * point:		the point
+ * cell:		the indices (x, y) of the cell
+ *
+ * returns:		1 if the point is inside the grid, 0 otherwise
+ */
+int getPointCell(DelaunayTriangulation *delTri, DTfloat point[2], DTsize cell[2]) {
+	DTsize n[2] = {delTri->grid_nx, delTri->grid_ny};
+	int inside = 1;
+
+	for (int k = 0; k < 2; k++) {
+		double c = floor((point[k] - delTri->grid_min[k]) * delTri->grid_inv_size);
+		if (c < 0) {
+			cell[k] = 0;
+			inside = 0;
+		}
+		else if (c >= n[k]) {
+			cell[k] = n[k] - 1;
+			inside = 0;
+		}
+		else {
+			cell[k] = (DTsize) c;
+		}
+	}
+	return inside;
+}
 
-	if ((delTri->edges == NULL) && (delTri->n_points > 1)) {
-		printf("ERROR: Couldn't allocate memory for edges\n");
-		free(delTri);
-		exit(1);
+/*
+ * Adds a point to the grid, if built. The grid is dropped (and will be built
+ * again when needed) when it becomes too crowded.
+ *
+ * delTri:		the DelaunayTriangulation structure
+ * i_p:			the index of the point
+ */
+void addPointToGrid(DelaunayTriangulation *delTri, DTsize i_p) {
+	DTsize cell[2];
+
+	if (delTri->grid_nx == 0) return;
+
+	if (i_p >= delTri->grid_next_max) {
+		DTsize *next = realloc(delTri->grid_next, sizeof(DTsize) * delTri->n_points_max);
+		if (next == NULL) {
+			delTri->grid_nx = delTri->grid_ny = 0;
+			return;
+		}
+		delTri->grid_next = next;
+		delTri->grid_next_max = delTri->n_points_max;
 	}
 
-	delTri->success = 0;
+	if (!getPointCell(delTri, delTri->points[i_p], cell)) {
+		delTri->grid_n_outside++;
+	}
+	delTri->grid_n_points++;
+
+	if ((delTri->grid_n_points > GRID_MAX_LOAD * delTri->grid_nx * delTri->grid_ny) ||
+		(delTri->grid_n_outside > GRID_MAX_LOAD + delTri->grid_n_points / GRID_MAX_LOAD)) {
+		delTri->grid_nx = delTri->grid_ny = 0;
+		return;
+	}
+
+	DTsize c = cell[1] * delTri->grid_nx + cell[0];
+	delTri->grid_next[i_p] = delTri->grid_cells[c];
+	delTri->grid_cells[c] = i_p;
+}
+
+/*
+ * Removes a point from the grid, if built. Must be called before the point
+ * is modified.
+ *
+ * delTri:		the DelaunayTriangulation structure
+ * i_p:			the index of the point
+ */
+void removePointFromGrid(DelaunayTriangulation *delTri, DTsize i_p) {
+	DTsize cell[2];
+
+	if (delTri->grid_nx == 0) return;
+
+	if (!getPointCell(delTri, delTri->points[i_p], cell)) {
+		delTri->grid_n_outside--;
+	}
+	delTri->grid_n_points--;
+
+	DTsize *link = &delTri->grid_cells[cell[1] * delTri->grid_nx + cell[0]];
+	while (*link != i_p) {
+		link = &delTri->grid_next[*link];
+	}
+	*link = delTri->grid_next[i_p];
+}
+
+/*
+ * Updates the closest point to a given point with the points of a cell of
+ * the grid.
+ *
+ * delTri:			the DelaunayTriangulation structure
+ * cx, cy:			the indices of the cell
+ * point:			the point to compare
+ * closest_idx:		the index of the closest point found so far
+ * closest_dist:	the squared distance to the closest point found so far
+ */
+void getClosestPointInCell(DelaunayTriangulation *delTri, DTsize cx, DTsize cy, DTfloat point[2],
+						   DTsize *closest_idx, DTfloat *closest_dist) {
+	DTfloat dx, dy, dist;
+
+	for (DTsize i = delTri->grid_cells[cy * delTri->grid_nx + cx]; i != -1; i = delTri->grid_next[i]) {
+		dx = point[0] - delTri->points[i][0];
+		dy = point[1] - delTri->points[i][1];
+		dist = (dx*dx) + dy*dy;
+		if ((dist < *closest_dist) || ((dist == *closest_dist) && (i < *closest_idx))) {
+			*closest_idx = i;
+			*closest_dist = dist;
+		}
+	}
 }
 
 /*
@@ -126,26 +351,35 @@ void resetDelaunayTriangulation(DelaunayTriangulation *delTri) {
  *
  * returns:		the index of the closest point, -1 if cannot find any point
  */
-GLsizei getPointIndex(DelaunayTriangulation *delTri, GLfloat point[2]) {
-	if (delTri->n_points == 0) {
+DTsize getPointIndex(DelaunayTriangulation *delTri, DTfloat point[2]) {
+	DTsize cell[2], r, x, y;
+	DTsize closest_idx = -1;
+	DTfloat closest_dist = INFINITY;
+	double size, reach;
+
+	if ((delTri->grid_nx == 0) && (!buildPointGrid(delTri))) {
 		return -1;
 	}
 
-	GLsizei i;
-	GLsizei closest_idx = 0;
-	GLfloat dx, dy, dist;
-	dx = point[0] - delTri->points[0][0];
-	dy = point[1] - delTri->points[0][1];
-	GLfloat closest_dist = dx * dx + dy * dy;
+	// Rings of cells around the point, until no cell can be closer
+	getPointCell(delTri, point, cell);
+	size = 1 / delTri->grid_inv_size;
+	reach = MAX(MAX(cell[0], delTri->grid_nx - 1 - cell[0]), MAX(cell[1], delTri->grid_ny - 1 - cell[1]));
 
-	for (i = 1; i < delTri->n_points; i++) {
-		dx = point[0] - delTri->points[i][0];
-		dy = point[1] - delTri->points[i][1];
-		dist = (dx*dx) + dy*dy;
-		if (dist < closest_dist) {
-			closest_idx = i;
-			closest_dist = dist;
+	for (r = 0; r <= reach; r++) {
+		for (y = MAX(cell[1] - r, 0); y <= MIN(cell[1] + r, delTri->grid_ny - 1); y++) {
+			if ((y == cell[1] - r) || (y == cell[1] + r)) {
+				for (x = MAX(cell[0] - r, 0); x <= MIN(cell[0] + r, delTri->grid_nx - 1); x++) {
+					getClosestPointInCell(delTri, x, y, point, &closest_idx, &closest_dist);
+				}
+			}
+			else {
+				if (cell[0] - r >= 0) getClosestPointInCell(delTri, cell[0] - r, y, point, &closest_idx, &closest_dist);
+				if (cell[0] + r < delTri->grid_nx) getClosestPointInCell(delTri, cell[0] + r, y, point, &closest_idx, &closest_dist);
+			}
 		}
+		// Points in the next ring are at least r cells away
+		if ((r * size) * (r * size) > closest_dist) break;
 	}
 	return closest_idx;
 }
@@ -159,10 +393,10 @@ GLsizei getPointIndex(DelaunayTriangulation *delTri, GLfloat point[2]) {
  *
  * returns:		the distance to the closest point
  */
-GLfloat getDistanceToClosestPoint(DelaunayTriangulation *delTri, GLfloat point[2]) {
-	GLsizei idx = getPointIndex(delTri, point);
+DTfloat getDistanceToClosestPoint(DelaunayTriangulation *delTri, DTfloat point[2]) {
+	DTsize idx = getPointIndex(delTri, point);
 	if (idx != -1) {
-		GLfloat dx, dy;
+		DTfloat dx, dy;
 		dx = point[0] - delTri->points[idx][0];
 		dy = point[1] - delTri->points[idx][1];
 		return dx * dx + dy * dy;
@@ -179,77 +413,142 @@ GLfloat getDistanceToClosestPoint(DelaunayTriangulation *delTri, GLfloat point[2
  * i_p:			the index of the point to modify
  * point:		the new point
  */
-void updatePointAtIndex(DelaunayTriangulation *delTri, GLsizei i_p, GLfloat point[2]) {
-	delTri->points[i_p][0] = point[0];
-	delTri->points[i_p][1] = point[1];
-	resetDelaunayTriangulation(delTri);
+void updatePointAtIndex(DelaunayTriangulation *delTri, DTsize i_p, DTfloat point[2]) {
+	if (POINT_DELETED(delTri, i_p)) {
+		return;
+	}
+	delTri->sorted = 0;
+	delTri->arranged = 0;
+	removePointFromGrid(delTri, i_p);
+	if ((!delTri->success) || (!movePoint(delTri, i_p, point))) {
+		delTri->points[i_p][0] = point[0];
+		delTri->points[i_p][1] = point[1];
+		resetDelaunayTriangulation(delTri);
+	}
+	addPointToGrid(delTri, i_p);
 }
 
 /*
- * Adds a point in the DelaunayTriangulation.
+ * Adds a point in the DelaunayTriangulation. If the triangulation was already
+ * computed, the point is inserted in it, only modifying the triangles around
+ * the point, otherwise the triangulation will be computed from scratch.
+ * The index of a previously deleted point is reused if any.
  *
  * delTri:		the DelaunayTriangulation structure
  * point:		the point to add
  *
  * returns:		1 if point was correctly added, -1 otherwise (means the point is to close to an already existing point)
  */
-int addPoint(DelaunayTriangulation *delTri, GLfloat point[2]) {
+int addPoint(DelaunayTriangulation *delTri, DTfloat point[2]) {
 	if (getDistanceToClosestPoint(delTri, point) <= MIN_DIST) {
 		return 0;
 	}
 
-	GLsizei idx = delTri->n_points;
-	delTri->n_points += 1;
+	DTsize idx;
 
-	GLfloat (*points)[2];
-	if (delTri->points == NULL) {
-		delTri->points = malloc(sizeof(delTri->points[0]) * delTri->n_points);
+	if (delTri->n_free_points > 0) {
+		idx = delTri->free_points[--delTri->n_free_points];
 	}
-	points = realloc(delTri->points, sizeof(delTri->points[0]) * delTri->n_points);
-	if (points == 0) {
-		printf("ERROR: Couldn't allocate more memory for points\n");
-		exit(1);
+	else if (delTri->n_points < delTri->n_points_max) {
+		idx = delTri->n_points++;
+	}
+	else {
+		DTsize n_points_max = MAX(2 * delTri->n_points_max, 16);
+		DTfloat (*points)[2];
+		if (delTri->points_owned) {
+			points = realloc(delTri->points, sizeof(delTri->points[0]) * n_points_max);
+		}
+		else {
+			// Borrowed points are copied to an array that can grow
+			points = malloc(sizeof(delTri->points[0]) * n_points_max);
+			if (points != NULL) memcpy(points, delTri->points, sizeof(delTri->points[0]) * delTri->n_points);
+			delTri->points_owned = 1;
+		}
+		if (points == NULL) {
+			printf("ERROR: Couldn't allocate more memory for points\n");
+			exit(1);
+		}
+		delTri->points = points;
+		delTri->n_points_max = n_points_max;
+		idx = delTri->n_points++;
 	}
-	delTri->points = points;
+
 	delTri->points[idx][0] = point[0];
 	delTri->points[idx][1] = point[1];
+	delTri->sorted = 0;
+	delTri->arranged = 0;
+	addPointToGrid(delTri, idx);
 
-	resetDelaunayTriangulation(delTri);
+	if ((!delTri->success) || (!insertPoint(delTri, idx))) {
+		resetDelaunayTriangulation(delTri);
+	}
 	return 1;
 }
 
 /*
- * Removes a point from the DelaunayTriangulation.
+ * Removes a point from the DelaunayTriangulation. If the triangulation was
+ * already computed, only the triangles around the point are modified.
+ * The index of the point is kept aside to be reused by addPoint, so that the
+ * indices of the other points do not change until the next full triangulation.
  *
  * delTri:		the DelaunayTriangulation structure
  * i_p:			the index of the point to delete
  *
  * returns:		1 if point was correctly added, -1 otherwise (if no point to remove)
  */
-int deletePointAtIndex(DelaunayTriangulation *delTri, GLsizei i_p) {
-	if (delTri->n_points == 0) {
+int deletePointAtIndex(DelaunayTriangulation *delTri, DTsize i_p) {
+	if ((i_p < 0) || (i_p >= delTri->n_points) || (POINT_DELETED(delTri, i_p))) {
 		return 0;
 	}
 
-	delTri->n_points -= 1;
-	GLfloat (*points)[2] = malloc(sizeof(delTri->points[0]) * delTri->n_points);
-
-	for (GLsizei i = 0; i < i_p; i++) {
-		points[i][0] = delTri->points[i][0];
-		points[i][1] = delTri->points[i][1];
+	if (delTri->n_free_points == delTri->n_free_points_max) {
+		DTsize n_free_points_max = MAX(2 * delTri->n_free_points_max, 16);
+		DTsize *free_points = realloc(delTri->free_points, sizeof(DTsize) * n_free_points_max);
+		if (free_points == NULL) {
+			printf("ERROR: Couldn't allocate more memory for deleted points\n");
+			exit(1);
+		}
+		delTri->free_points = free_points;
+		delTri->n_free_points_max = n_free_points_max;
 	}
-	for (GLsizei i = i_p; i < delTri->n_points; i++) {
-		points[i][0] = delTri->points[i + 1][0];
-		points[i][1] = delTri->points[i + 1][1];
+
+	if ((delTri->success) && (!removePoint(delTri, i_p))) {
+		resetDelaunayTriangulation(delTri);
 	}
+	removePointFromGrid(delTri, i_p);
 
-	free(delTri->points);
-	delTri->points = points;
+	delTri->points[i_p][0] = NAN;
+	delTri->points[i_p][1] = NAN;
+	delTri->free_points[delTri->n_free_points++] = i_p;
 
-	resetDelaunayTriangulation(delTri);
 	return 1;
 }
 
+/*
+ * Removes the deleted points from the array of points, which changes the
+ * indices of the points. Must only be run when the triangulation is reset.
+ *
+ * delTri:		the DelaunayTriangulation structure
+ */
+void compactPoints(DelaunayTriangulation *delTri) {
+	if (delTri->n_free_points == 0) {
+		return;
+	}
+
+	DTsize c = 0;
+	for (DTsize i = 0; i < delTri->n_points; i++) {
+		if (!POINT_DELETED(delTri, i)) {
+			delTri->points[c][0] = delTri->points[i][0];
+			delTri->points[c][1] = delTri->points[i][1];
+			c++;
+		}
+	}
+	delTri->n_points = c;
+	delTri->n_free_points = 0;
+	delTri->arranged = 0;	// sorted points stay sorted, but the halves of arranged points change
+	delTri->grid_nx = delTri->grid_ny = 0;
+}
+
 /*
  * Removes a point from the DelaunayTriangulation.
  *
@@ -258,8 +557,8 @@ int deletePointAtIndex(DelaunayTriangulation *delTri, GLsizei i_p) {
  *
  * returns:		1 if point was correctly added, -1 otherwise (if no point to remove)
  */
-int deletePoint(DelaunayTriangulation *delTri, GLfloat point[2]) {
-	GLsizei idx = getPointIndex(delTri, point);
+int deletePoint(DelaunayTriangulation *delTri, DTfloat point[2]) {
+	DTsize idx = getPointIndex(delTri, point);
 	if (idx != -1) {
 		return deletePointAtIndex(delTri, idx);
 	}
@@ -276,8 +575,25 @@ int deletePoint(DelaunayTriangulation *delTri, GLfloat point[2]) {
  */
 void freeDelaunayTriangulation(DelaunayTriangulation *delTri) {
 	if (delTri != NULL) {
-		if (delTri->points != NULL) free(delTri->points);
-		if (delTri->edges != NULL) free(delTri->edges);
+		if ((delTri->points != NULL) && (delTri->points_owned)) free(delTri->points);
+		for (DTsize i = 0; i < delTri->n_edge_chunks; i++) {
+			free(delTri->edge_chunks[i]);
+#if COMPACT_EDGES
+			free(delTri->edge_flags[i]);
+#endif
+		}
+		if (delTri->edge_chunks != NULL) free(delTri->edge_chunks);
+		if (delTri->edge_stack != NULL) free(delTri->edge_stack);
+		if (delTri->free_points != NULL) free(delTri->free_points);
+		if (delTri->grid_cells != NULL) free(delTri->grid_cells);
+		if (delTri->grid_next != NULL) free(delTri->grid_next);
+		if (delTri->triangles != NULL) free(delTri->triangles);
+		if (delTri->triangles_edges != NULL) free(delTri->triangles_edges);
+		if (delTri->triangles_neighbors != NULL) free(delTri->triangles_neighbors);
+		if (delTri->edges_triangle != NULL) free(delTri->edges_triangle);
+#if COMPACT_EDGES
+		if (delTri->edge_flags != NULL) free(delTri->edge_flags);
+#endif
 		free(delTri);
 	}
 }
@@ -291,17 +607,65 @@ void describeDelaunayTriangulation(DelaunayTriangulation *delTri) {
 
 	printf("DelaunayTriangulation structure stored at %p.\n"
 		   "\t- Number of points:           %d\n"
+		   "\t- Number of deleted points:   %d\n"
 		   "\t- Address of points:          %p\n"
 		   "\t- Number of edges:            %d\n"
 		   "\t- Number of discarded edges:  %d\n"
 		   "\t- Maximum number of edges:    %d\n"
-		   "\t- Address of edges:           %p\n"
+		   "\t- Number of edge chunks:      %d\n"
 		   "\t- Triangulation computed?:    %d\n",
 		   delTri,
-		   delTri->n_points, delTri->points,
-	   	   delTri->n_edges, delTri->n_edges_discarded, delTri->n_edges_max, delTri->edges,
+		   delTri->n_points, delTri->n_free_points, delTri->points,
+	   	   delTri->n_edges, delTri->n_edges_discarded, delTri->n_edges_max, delTri->n_edge_chunks,
 	   	   delTri->success);
 	if (delTri->success) printf("\t- Number of triangles:        %d\n", getNumberOfTriangles(delTri));
+#if PREDICATE_STATS
+	printf("\t- orient2d (filter/adaptive/exact): %lu/%lu/%lu\n"
+		   "\t- incircle (filter/adaptive/exact): %lu/%lu/%lu\n",
+		   orient2d_stats[PREDICATE_FILTER], orient2d_stats[PREDICATE_ADAPTIVE], orient2d_stats[PREDICATE_EXACT],
+		   incircle_stats[PREDICATE_FILTER], incircle_stats[PREDICATE_ADAPTIVE], incircle_stats[PREDICATE_EXACT]);
+#endif
+#if DT_STATS
+	DTStats *stats = &delTri->stats;
+	printf("\t- orient2d (calls/exact):      %lu/%lu\n"
+		   "\t- incircle (calls/exact):      %lu/%lu\n"
+		   "\t- Edges (created/deleted):     %lu/%lu\n"
+		   "\t- Merge steps (loop/tangent):  %lu/%lu\n"
+		   "\t- Recursion depth:             %lu\n",
+		   stats->orient2d_calls, stats->orient2d_exact, stats->incircle_calls, stats->incircle_exact,
+		   stats->edges_created, stats->edges_deleted, stats->merge_steps, stats->tangent_steps,
+		   stats->max_depth);
+#endif
+}
+
+/*
+ * Returns the number of points in the DelaunayTriangulation, excluding the
+ * deleted points.
+ *
+ * delTri:		the DelaunayTriangulation structure
+ *
+ * returns:		the number of points
+ */
+DTsize getDelaunayTriangulationNumberOfPoints(DelaunayTriangulation *delTri) {
+	return delTri->n_points - delTri->n_free_points;
+}
+
+/*
+ * Populates an array with the points of the DelaunayTriangulation, excluding
+ * the deleted points.
+ *
+ * delTri:		the DelaunayTriangulation structure
+ * points:		the preallocated array that will contain the points
+ */
+void getDelaunayTriangulationPoints(DelaunayTriangulation *delTri, DTfloat points[][2]) {
+	DTsize c = 0;
+	for (DTsize i = 0; i < delTri->n_points; i++) {
+		if (!POINT_DELETED(delTri, i)) {
+			points[c][0] = delTri->points[i][0];
+			points[c][1] = delTri->points[i][1];
+			c++;
+		}
+	}
 }
 
 /*
@@ -312,7 +676,7 @@ void describeDelaunayTriangulation(DelaunayTriangulation *delTri) {
  *
  * returns:		the number of lines
  */
-GLsizei getDelaunayTriangulationNumberOfLines(DelaunayTriangulation *delTri) {
+DTsize getDelaunayTriangulationNumberOfLines(DelaunayTriangulation *delTri) {
 	return (delTri->n_edges - delTri->n_edges_discarded) / 2;
 }
 
@@ -325,24 +689,122 @@ GLsizei getDelaunayTriangulationNumberOfLines(DelaunayTriangulation *delTri) {
  * n_lines:		the number of lines
  */
 void getDelaunayTriangulationLines(DelaunayTriangulation *delTri,
-								   GLfloat lines[][2],
-							   	   GLsizei n_lines) {
+								   float lines[][2],
+							   	   DTsize n_lines) {
 
-	GLsizei e_i, l_i;
-	Edge *e;
+	DTsize e_i, l_i;
+	EdgeRef e;
 	l_i = 0;
 	for (e_i = 0; e_i < delTri->n_edges; e_i+=2) {
-		e = &(delTri->edges[e_i]);
-		if (e->discarded == 0) {
-			lines[l_i    ][0] = delTri->points[e->orig][0];
-			lines[l_i    ][1] = delTri->points[e->orig][1];
-			lines[l_i + 1][0] = delTri->points[e->dest][0];
-			lines[l_i + 1][1] = delTri->points[e->dest][1];
+		e = EDGE_REF(delTri, e_i);
+		if (!IS_DISCARDED(delTri, e)) {
+			lines[l_i    ][0] = delTri->points[ORIG(delTri, e)][0];
+			lines[l_i    ][1] = delTri->points[ORIG(delTri, e)][1];
+			lines[l_i + 1][0] = delTri->points[DEST(delTri, e)][0];
+			lines[l_i + 1][1] = delTri->points[DEST(delTri, e)][1];
 			l_i+=2;
 		}
 	}
 }
 
+/*
+ * Extracts the triangles of the DelaunayTriangulation, with their edges and
+ * neighbors, in one pass over the faces. The result is kept in the structure
+ * until the next modification of the triangulation (see version), so that all
+ * the queries on triangles share the same pass.
+ *
+ * delTri:		the DelaunayTriangulation structure
+ *
+ * returns:		1 if the triangles are up to date, 0 otherwise (not enough memory)
+ */
+int updateTriangles(DelaunayTriangulation *delTri) {
+	if (delTri->triangles_version == delTri->version) {
+		return 1;
+	}
+	delTri->n_triangles = 0;
+	if ((delTri->n_points < 3) || (!delTri->success)) {
+		delTri->triangles_version = delTri->version;
+		return 1;
+	}
+
+	if (delTri->edges_triangle_max < delTri->n_edges) {
+		DTsize *edges_triangle = realloc(delTri->edges_triangle, sizeof(DTsize) * delTri->n_edges);
+		if (edges_triangle == NULL) {
+			printf("ERROR: Couldn't allocate memory for triangles\n");
+			return 0;
+		}
+		delTri->edges_triangle = edges_triangle;
+		delTri->edges_triangle_max = delTri->n_edges;
+	}
+
+	// Each inner face uses 3 of the (half) edges
+	DTsize n_triangles_max = (delTri->n_edges - delTri->n_edges_discarded) / 3;
+	if (delTri->n_triangles_max < n_triangles_max) {
+		DTsize (*triangles)[3] = realloc(delTri->triangles, sizeof(triangles[0]) * n_triangles_max);
+		if (triangles != NULL) delTri->triangles = triangles;
+		DTsize (*triangles_edges)[3] = realloc(delTri->triangles_edges, sizeof(triangles_edges[0]) * n_triangles_max);
+		if (triangles_edges != NULL) delTri->triangles_edges = triangles_edges;
+		DTsize (*triangles_neighbors)[3] = realloc(delTri->triangles_neighbors, sizeof(triangles_neighbors[0]) * n_triangles_max);
+		if (triangles_neighbors != NULL) delTri->triangles_neighbors = triangles_neighbors;
+		if ((triangles == NULL) || (triangles_edges == NULL) || (triangles_neighbors == NULL)) {
+			printf("ERROR: Couldn't allocate memory for triangles\n");
+			return 0;
+		}
+		delTri->n_triangles_max = n_triangles_max;
+	}
+
+	// -2 if not visited yet
+	DTsize *edges_triangle = delTri->edges_triangle;
+	for (DTsize i = 0; i < delTri->n_edges; i++) edges_triangle[i] = -2;
+
+	DTsize i_tri = 0;
+	EdgeRef e, face[3];
+
+	for (DTsize i = 0; i < delTri->n_edges; i++) {
+		e = EDGE_REF(delTri, i);
+		if ((IS_DISCARDED(delTri, e)) || (edges_triangle[i] != -2)) continue;
+
+		// Walking the face backwards, so its edges are face[0], face[2], face[1]
+		DTsize n_face_edges = 0;
+		do {
+			if (n_face_edges < 3) face[n_face_edges] = e;
+			n_face_edges++;
+			e = SYM(delTri, ONEXT(delTri, e));
+		} while (EDGE_IDX(delTri, e) != i);
+
+		// The outside is the only face that is not a counterclockwise triangle
+		int inside = (n_face_edges == 3) && (orient2d(delTri->points[ORIG(delTri, face[0])],
+													  delTri->points[ORIG(delTri, face[2])],
+													  delTri->points[ORIG(delTri, face[1])]) > 0);
+
+		do {
+			edges_triangle[EDGE_IDX(delTri, e)] = inside ? i_tri : -1;
+			e = SYM(delTri, ONEXT(delTri, e));
+		} while (EDGE_IDX(delTri, e) != i);
+
+		if (inside) {
+			delTri->triangles[i_tri][0] = ORIG(delTri, face[0]);
+			delTri->triangles[i_tri][1] = ORIG(delTri, face[2]);
+			delTri->triangles[i_tri][2] = ORIG(delTri, face[1]);
+			delTri->triangles_edges[i_tri][0] = EDGE_IDX(delTri, face[0]);
+			delTri->triangles_edges[i_tri][1] = EDGE_IDX(delTri, face[2]);
+			delTri->triangles_edges[i_tri][2] = EDGE_IDX(delTri, face[1]);
+			i_tri++;
+		}
+	}
+
+	for (DTsize t = 0; t < i_tri; t++) {
+		for (int k = 0; k < 3; k++) {
+			e = SYM(delTri, EDGE_REF(delTri, delTri->triangles_edges[t][k]));
+			delTri->triangles_neighbors[t][k] = edges_triangle[EDGE_IDX(delTri, e)];
+		}
+	}
+
+	delTri->n_triangles = i_tri;
+	delTri->triangles_version = delTri->version;
+	return 1;
+}
+
 /*
  * Returns the number of triangles in the DelaunayTriangulation.
  *
@@ -350,29 +812,59 @@ void getDelaunayTriangulationLines(DelaunayTriangulation *delTri,
  *
  * returns:		the number of of triangles
  */
-GLsizei getNumberOfTriangles(DelaunayTriangulation *delTri) {
-	if ((delTri->n_points < 3) || (!delTri->success)) {
+DTsize getNumberOfTriangles(DelaunayTriangulation *delTri) {
+	if (!updateTriangles(delTri)) {
 		return 0;
 	}
-	char *visited_edges = calloc(delTri->n_edges, sizeof(char));
-	GLsizei n_triangles = 0;
-	Edge *e;
+	return delTri->n_triangles;
+}
 
-	for (GLsizei i = 0; i < delTri->n_edges; i++) {
-		e = &(delTri->edges[i]);
-		if ((!e->discarded) && (visited_edges[i] == 0)) {
-			do {
-				visited_edges[e->idx] = 1;
-				e = e->onext->sym;
-			} while (e->idx != i);
-			n_triangles ++;
-		}
+/*
+ * Populates an array with the triangles of the DelaunayTriangulation, as
+ * counterclockwise triples of point indices. The indices refer to the points
+ * given by getDelaunayTriangulationPoints, i.e. excluding the deleted points.
+ * Optionally, populates a second array with, for each triangle, the index of
+ * the triangle on the other side of each of its edges (the edge k going from
+ * its point k to its point (k + 1) % 3), -1 on the convex hull.
+ *
+ * delTri:		the DelaunayTriangulation structure
+ * triangles:	the preallocated array that will contain the triangles, of at
+ *				least getNumberOfTriangles(delTri) triangles
+ * neighbors:	the preallocated array that will contain the neighbors, or NULL
+ *
+ * returns:		the number of triangles, 0 if not enough memory
+ */
+DTsize getDelaunayTriangulationTriangles(DelaunayTriangulation *delTri,
+										 DTsize triangles[][3],
+										 DTsize neighbors[][3]) {
+	if (!updateTriangles(delTri)) {
+		return 0;
 	}
+	DTsize n_triangles = delTri->n_triangles;
 
-	if (visited_edges != NULL) free(visited_edges);
+	memcpy(triangles, delTri->triangles, sizeof(triangles[0]) * n_triangles);
+	if (neighbors != NULL) {
+		memcpy(neighbors, delTri->triangles_neighbors, sizeof(neighbors[0]) * n_triangles);
+	}
 
-	return n_triangles - 1; // Remove the "outside"
+	// New index of each point, if some points are deleted
+	if (delTri->n_free_points > 0) {
+		DTsize *points_index = malloc(sizeof(DTsize) * delTri->n_points);
+		if (points_index == NULL) {
+			printf("ERROR: Couldn't allocate memory for triangles\n");
+			return 0;
+		}
+		DTsize c = 0;
+		for (DTsize i = 0; i < delTri->n_points; i++) {
+			points_index[i] = POINT_DELETED(delTri, i) ? -1 : c++;
+		}
+		for (DTsize t = 0; t < n_triangles; t++) {
+			for (int k = 0; k < 3; k++) triangles[t][k] = points_index[triangles[t][k]];
+		}
+		free(points_index);
+	}
 
+	return n_triangles;
 }
 
 /*
@@ -382,43 +874,22 @@ GLsizei getNumberOfTriangles(DelaunayTriangulation *delTri) {
  *
  * returns:		the smallest angle in the triangulation
  */
-GLfloat getSmallestAngle(DelaunayTriangulation *delTri) {
-	if ((delTri->n_points < 3) || (!delTri->success)) {
+float getSmallestAngle(DelaunayTriangulation *delTri) {
+	if ((!updateTriangles(delTri)) || (delTri->n_triangles == 0)) {
 		return INFINITY;
 	}
-	char *visited_edges = calloc(delTri->n_edges, sizeof(char));
-	GLfloat angle, smallest_angle;
+	float angle, smallest_angle;
 	angle = smallest_angle = INFINITY;
-	Edge *e;
-
-	int outside_found = 0;
-
-   	for (GLsizei i = 0; i < delTri->n_edges; i++) {
-   		e = &(delTri->edges[i]);
-   		if ((!e->discarded) && (visited_edges[i] == 0)) {
-			// Only one set of edges is on the exterior
-			// Once it's found, no need to check anymore
-			if ((!outside_found) && (pointCompareEdge(delTri, e->onext->dest, e) == 1)) {
-				do {
-					// Edge has been now visited
-	   				visited_edges[e->idx] = 1;
-	   				e = e->onext->sym;
-	   			} while (e->idx != i);
-				outside_found = 1;
-			}
-			else {
-				do {
-					// Edge has been now visited
-	   				visited_edges[e->idx] = 1;
-					angle = angleBetweenContiguousEdges(delTri, e, e->onext->sym);
-					smallest_angle = MIN(angle, smallest_angle);
-	   				e = e->onext->sym;
-	   			} while (e->idx != i);
-			}
-   		}
-   	}
 
-	if (visited_edges != NULL) free(visited_edges);
+	for (DTsize t = 0; t < delTri->n_triangles; t++) {
+		for (int k = 0; k < 3; k++) {
+			// Edge k ends where edge (k + 1) % 3 starts, the angle is between them
+			angle = angleBetweenContiguousEdges(delTri,
+												EDGE_REF(delTri, delTri->triangles_edges[t][k]),
+												SYM(delTri, EDGE_REF(delTri, delTri->triangles_edges[t][(k + 1) % 3])));
+			smallest_angle = MIN(angle, smallest_angle);
+		}
+	}
 
 	return smallest_angle;
 
@@ -428,7 +899,8 @@ GLfloat getSmallestAngle(DelaunayTriangulation *delTri) {
  * Populates an array of n_triangles points with the center of each the
  * circumscribed circle in the DelaunayTriangulation.
  * Addionally, populates an second array with, for each triangle, the indices
- * of the neighboring triangles. -1 means that the neighbors is the "outside".
+ * of the neighboring triangles. If the neighbor is the "outside", n_triangles
+ * plus the index of the edge on the other side is stored instead.
  *
  * delTri:		the DelaunayTriangulation structure
  * centers:		the preallocated array that will contain the centers
@@ -436,76 +908,28 @@ GLfloat getSmallestAngle(DelaunayTriangulation *delTri) {
  * n_triangles:	the number of triangles (centers)
  */
 void getVoronoiCentersAndNeighbors(DelaunayTriangulation *delTri,
-								   GLfloat centers[][2],
-								   GLsizei neighbors[][3],
-							   	   GLsizei n_triangles) {
+								   float centers[][2],
+								   DTsize neighbors[][3],
+							   	   DTsize n_triangles) {
 
-	if ((delTri->n_points < 3) || (!delTri->success)) {
+	if ((!updateTriangles(delTri)) || (delTri->n_triangles != n_triangles)) {
 		return;
 	}
 
-	// First, allocate some
-   	char *visited_edges = calloc(delTri->n_edges, sizeof(char));
-	GLsizei *edges_triangle = malloc(sizeof(GLsizei) * delTri->n_edges);
-
-	GLsizei i_tri, i_e;
-	i_tri = 0;
-
-   	Edge *e;
-	int outside_found = 0;
-
-	GLsizei triPoints[3] = {0, 0, 0};
-
-   	for (GLsizei i = 0; i < delTri->n_edges; i++) {
-   		e = &(delTri->edges[i]);
-   		if ((!e->discarded) && (visited_edges[i] == 0)) {
-			// Only one set of edges is on the exterior
-			// Once it's found, no need to check anymore
-			if ((!outside_found) && (pointCompareEdge(delTri, e->onext->dest, e) == 1)) {
-				do {
-					// Edge has been now visited
-	   				visited_edges[e->idx] = 1;
-					// If the triangle is the outside, we store n_triangles + i_e
-					// to later retrieve i_e without needed additional structure
-					edges_triangle[e->idx] = n_triangles + e->idx ; // n_triangles = "outside"
-	   				e = e->onext->sym;
-	   			} while (e->idx != i);
-				outside_found = 1;
-			}
-			else {
-				i_e = 0;
-				do {
-					// Edge has been now visited
-	   				visited_edges[e->idx] = 1;
-
-					// This edge is inside triangles[i_tri] but has neighbor
-					// given by the edge's symetrical
-					neighbors[i_tri][i_e] = e->sym->idx;
-					edges_triangle[e->idx] = i_tri;
-					triPoints[i_e] = e->orig;
-	   				e = e->onext->sym;
-					i_e++;
-	   			} while (e->idx != i);
-
-				circleCenter(delTri, triPoints[0], triPoints[1], triPoints[2], centers[i_tri]);
-
-				i_tri++;
-			}
-   		}
-   	}
-
-	// Each triangle will now have have its neighbors to be Voronoi centers
-	for(i_tri = 0; i_tri < n_triangles; i_tri++) {
-		neighbors[i_tri][0] = edges_triangle[neighbors[i_tri][0]];
-		neighbors[i_tri][1] = edges_triangle[neighbors[i_tri][1]];
-		neighbors[i_tri][2] = edges_triangle[neighbors[i_tri][2]];
+	for (DTsize t = 0; t < n_triangles; t++) {
+		DTsize *triangle = delTri->triangles[t];
+		// Same order as the faces are walked, clockwise
+		circleCenter(delTri, triangle[0], triangle[2], triangle[1], centers[t]);
 
+		for (int k = 0; k < 3; k++) {
+			neighbors[t][k] = delTri->triangles_neighbors[t][k];
+			if (neighbors[t][k] == -1) {
+				// Edge on the other side, retrieved later without needed additional structure
+				neighbors[t][k] = n_triangles + EDGE_IDX(delTri, SYM(delTri, EDGE_REF(delTri, delTri->triangles_edges[t][k])));
+			}
+		}
 	}
 
-	// Free allocated memory
-   	if (visited_edges != NULL) free(visited_edges);
-	if (edges_triangle != NULL) free(edges_triangle);
-
 }
 
 /*
@@ -519,21 +943,21 @@ void getVoronoiCentersAndNeighbors(DelaunayTriangulation *delTri,
  * n_triangles:	the number of triangles (centers)
  */
 void getVoronoiLines(DelaunayTriangulation *delTri,
-					 GLfloat centers[][2],
-					 GLsizei neighbors[][3],
-					 GLfloat lines[][2],
-					 GLsizei n_triangles) {
+					 float centers[][2],
+					 DTsize neighbors[][3],
+					 float lines[][2],
+					 DTsize n_triangles) {
 
 	if ((delTri->n_points < 3) || (!delTri->success)) {
 		return;
 	}
 
-	GLsizei i_tri, i_nei, i;
-	GLsizei i_e;
-	GLfloat x, y, xa, ya, xb, yb, m, p, det, xp, yp, factor, dx;
-	GLfloat *a, *b;
+	DTsize i_tri, i_nei, i;
+	DTsize i_e;
+	float x, y, xa, ya, xb, yb, m, p, det, xp, yp, factor, dx;
+	DTfloat *a, *b, center[2];
 
-	GLsizei l_i = 0;
+	DTsize l_i = 0;
 
 	for(i_tri = 0; i_tri < n_triangles; i_tri++) {
 		for (i = 0; i < 3; i++) {
@@ -547,10 +971,10 @@ void getVoronoiLines(DelaunayTriangulation *delTri,
 				// Circumcenter is projected on the edge
 
 				i_e = i_nei - n_triangles;
-				a = delTri->points[delTri->edges[i_e].orig];
+				a = delTri->points[ORIG(delTri, EDGE_REF(delTri, i_e))];
 				xa = a[0];
 				ya = a[1];
-				b = delTri->points[delTri->edges[i_e].dest];
+				b = delTri->points[DEST(delTri, EDGE_REF(delTri, i_e))];
 				xb = b[0];
 				yb = b[1];
 
@@ -573,7 +997,9 @@ void getVoronoiLines(DelaunayTriangulation *delTri,
 
 				// If point is on the left, then it is outside the convex hull
 				// and the ligne must point outward
-				if (orient2d(centers[i_tri], a, b) > 0) {
+				center[0] = x;
+				center[1] = y;
+				if (orient2d(center, a, b) > 0) {
 					factor = - factor;
 				}
 
@@ -591,110 +1017,451 @@ void getVoronoiLines(DelaunayTriangulation *delTri,
 }
 
 /*
- * Save the last DelaunayTriangulation status in the file.
- * This will contains the points in the triangulation and, if success, the points
- * forming all the lines in the triangulation.
+ * Clips a convex polygon by the half-plane of the points closer to p than
+ * to q (Sutherland-Hodgman).
  *
- * delTri:		the DelaunayTriangulation structure
- * file_out:	the output file (already open)
+ * polygon:		the n vertices of the polygon
+ * n:			the number of vertices
+ * p, q:		the two points
+ * clipped:		the array that will contain the at most n + 1 vertices of the clipped polygon
+ *
+ * returns:		the number of vertices of the clipped polygon
  */
-void fsaveDelaunayTriangulation(DelaunayTriangulation *delTri, FILE* file_out) {
-	GLsizei n_lines_points = 2 * getDelaunayTriangulationNumberOfLines(delTri);
-
-	fprintf(file_out, "%d %d\n", delTri->n_points, n_lines_points);
-
-	GLsizei i = 0;
-
-	for (i = 0; i < delTri->n_points; i++) {
-		fprintf(file_out, "%lf %lf\n", delTri->points[i][0], delTri->points[i][1]);
-	}
-
-	GLfloat (*linesPoints)[2] = malloc(sizeof(linesPoints[0]) * n_lines_points);
-	getDelaunayTriangulationLines(delTri, linesPoints, n_lines_points / 2);
-
-	for (i = 0; i < n_lines_points; i++) {
-		fprintf(file_out, "%lf %lf\n", linesPoints[i][0], linesPoints[i][1]);
+static DTsize clipPolygonByBisector(double polygon[][2], DTsize n, const DTfloat p[2], const DTfloat q[2],
+									double clipped[][2]) {
+	double dx = (double) q[0] - p[0], dy = (double) q[1] - p[1];
+	double mx = 0.5 * ((double) q[0] + p[0]), my = 0.5 * ((double) q[1] + p[1]);
+	DTsize m = 0;
+
+	for (DTsize i = 0; i < n; i++) {
+		double *a = polygon[i], *b = polygon[(i + 1 == n) ? 0 : i + 1];
+		double fa = (a[0] - mx) * dx + (a[1] - my) * dy;
+		double fb = (b[0] - mx) * dx + (b[1] - my) * dy;
+		if (fa <= 0) {
+			clipped[m][0] = a[0];
+			clipped[m][1] = a[1];
+			m++;
+		}
+		if ((fa < 0 && fb > 0) || (fa > 0 && fb < 0)) {
+			double t = fa / (fa - fb);
+			clipped[m][0] = a[0] + t * (b[0] - a[0]);
+			clipped[m][1] = a[1] + t * (b[1] - a[1]);
+			m++;
+		}
 	}
-
-	if (linesPoints != NULL) free(linesPoints);
+	return m;
 }
 
-////////////////////////////////////////////////
-// End: DelaunayTriangulation structure utils //
-////////////////////////////////////////////////
-
-////////////////////////////////////////////////////////////////////////////////
-
-/////////////////////////////////
-// Begin: Edge structure utils //
-/////////////////////////////////
-
 /*
- * Creates a new edge in the triangulation, between two points, and returns the
- * index at which it is stored. It will also polulate the next edge as the
- * opposite (symetrical) edge of the one just created.
+ * Computes the Voronoi cell of each point of the DelaunayTriangulation,
+ * clipped to a rectangle, as a convex polygon. The cell of a point is the
+ * rectangle cut by the bisector of the point and each of its neighbors in the
+ * triangulation, so unbounded cells (on the convex hull) need no special care.
+ * The cells are computed in parallel.
  *
- * delTri: 		the DelaunayTriangulation structure
- * orig: 		the index of the origin point of the edge
- * dest: 		the index of the destination point of the edge
+ * The cells are stored in CSR form: the vertices of the cell of point i are
+ * vertices[offsets[i]] to vertices[offsets[i + 1] - 1], counterclockwise,
+ * without repeating the first one. Deleted points and points whose cell does
+ * not intersect the rectangle have empty cells.
  *
- * returns:		an Edge structure pointer to the main edge
+ * delTri:		the DelaunayTriangulation structure
+ * bounds:		the rectangle, as given by getPointsBoudingBox ({x_min, y_min}, {x_max, y_max})
+ * n_threads:	the number of threads, 0 to use all available threads
+ *
+ * returns:		the VoronoiCells (see freeVoronoiCells), NULL if they could not be computed
  */
-Edge* addEdge(DelaunayTriangulation *delTri, GLsizei orig, GLsizei dest) {
-	// Enough space ?
-	if (delTri->n_edges_max <= delTri->n_edges) {
-		printf("ERROR, no enough edges allocated\n");
-		exit(1);
+VoronoiCells* getVoronoiCells(DelaunayTriangulation *delTri, DTfloat bounds[][2], int n_threads) {
+	DTsize n = delTri->n_points;
+	int single = (getDelaunayTriangulationNumberOfPoints(delTri) == 1);
+
+	if ((!delTri->success) && (!single)) {
+		printf("ERROR: Voronoi cells need a triangulation\n");
+		return NULL;
 	}
 
-	Edge *e, *s;
+	VoronoiCells *cells = malloc(sizeof(VoronoiCells));
+	DTsize *points_edge = malloc(sizeof(DTsize) * (n + 1));
+	DTsize *slots = calloc(n + 1, sizeof(DTsize));
+	DTsize *counts = malloc(sizeof(DTsize) * MAX(n, 1));
+	if ((cells == NULL) || (points_edge == NULL) || (slots == NULL) || (counts == NULL)) {
+		printf("ERROR: Couldn't allocate memory for Voronoi cells\n");
+		free(cells); free(points_edge); free(slots); free(counts);
+		return NULL;
+	}
 
-	// Main edge
-	e = &(delTri->edges[delTri->n_edges]);
-	e->idx = delTri->n_edges;
-	delTri->n_edges += 1;
+	// One edge starting at each point, and at most one vertex per neighbor
+	// (plus the 4 corners) in the cell of each point
+	for (DTsize i = 0; i < n; i++) points_edge[i] = -1;
+	for (DTsize i = 0; (delTri->success) && (i < delTri->n_edges); i++) {
+		EdgeRef e = EDGE_REF(delTri, i);
+		if (IS_DISCARDED(delTri, e)) continue;
+		points_edge[ORIG(delTri, e)] = i;
+		slots[ORIG(delTri, e) + 1]++;
+	}
+	for (DTsize i = 0; i < n; i++) slots[i + 1] += slots[i] + 4;
 
-	e->discarded = 0;
-	e->orig = orig;
-	e->dest = dest;
+	DTfloat (*vertices)[2] = malloc(sizeof(vertices[0]) * MAX(slots[n], 1));
+	if (vertices == NULL) {
+		printf("ERROR: Couldn't allocate memory for Voronoi cells\n");
+		free(cells); free(points_edge); free(slots); free(counts);
+		return NULL;
+	}
+
+#ifdef _OPENMP
+	if (n_threads <= 0) n_threads = omp_get_max_threads();
+#else
+	n_threads = 1;
+#endif
+	int failed = 0;
+
+	#pragma omp parallel num_threads(n_threads)
+	{
+		DTsize polygon_max = 0;
+		double (*polygon)[2] = NULL, (*clipped)[2] = NULL, (*swap)[2];
+
+		#pragma omp for schedule(dynamic, 1024)
+		for (DTsize i = 0; i < n; i++) {
+			DTsize m = 0;
+
+			if ((!POINT_DELETED(delTri, i)) && ((points_edge[i] != -1) || (single))) {
+				if (polygon_max < slots[i + 1] - slots[i] + 1) {
+					DTsize size = 2 * (slots[i + 1] - slots[i] + 1);
+					double (*polygon_new)[2] = realloc(polygon, sizeof(polygon[0]) * size);
+					if (polygon_new != NULL) polygon = polygon_new;
+					double (*clipped_new)[2] = realloc(clipped, sizeof(clipped[0]) * size);
+					if (clipped_new != NULL) clipped = clipped_new;
+					if ((polygon_new == NULL) || (clipped_new == NULL)) {
+						#pragma omp atomic write
+						failed = 1;
+						counts[i] = 0;
+						continue;
+					}
+					polygon_max = size;
+				}
+
+				polygon[0][0] = bounds[0][0]; polygon[0][1] = bounds[0][1];
+				polygon[1][0] = bounds[1][0]; polygon[1][1] = bounds[0][1];
+				polygon[2][0] = bounds[1][0]; polygon[2][1] = bounds[1][1];
+				polygon[3][0] = bounds[0][0]; polygon[3][1] = bounds[1][1];
+				m = 4;
+
+				if (points_edge[i] != -1) {
+					EdgeRef e = EDGE_REF(delTri, points_edge[i]);
+					do {
+						m = clipPolygonByBisector(polygon, m, delTri->points[i], delTri->points[DEST(delTri, e)], clipped);
+						swap = polygon; polygon = clipped; clipped = swap;
+						e = ONEXT(delTri, e);
+					} while ((EDGE_IDX(delTri, e) != points_edge[i]) && (m > 0));
+				}
+
+				for (DTsize k = 0; k < m; k++) {
+					vertices[slots[i] + k][0] = polygon[k][0];
+					vertices[slots[i] + k][1] = polygon[k][1];
+				}
+			}
+			counts[i] = m;
+		}
+
+		free(polygon);
+		free(clipped);
+	}
+
+	if (failed) {
+		printf("ERROR: Couldn't allocate memory for Voronoi cells\n");
+		free(cells); free(points_edge); free(slots); free(counts); free(vertices);
+		return NULL;
+	}
+
+	// Removes the unused slots
+	cells->n_cells = n;
+	cells->offsets = points_edge;
+	cells->offsets[0] = 0;
+	DTsize c = 0;
+	for (DTsize i = 0; i < n; i++) {
+		memmove(vertices[c], vertices[slots[i]], sizeof(vertices[0]) * counts[i]);
+		c += counts[i];
+		cells->offsets[i] = c - counts[i];
+	}
+	cells->offsets[n] = c;
+	cells->vertices = realloc(vertices, sizeof(vertices[0]) * MAX(c, 1));
+	if (cells->vertices == NULL) cells->vertices = vertices;
+
+	free(slots);
+	free(counts);
+	return cells;
+}
+
+/*
+ * Frees VoronoiCells computed by getVoronoiCells.
+ *
+ * cells:		the VoronoiCells
+ */
+void freeVoronoiCells(VoronoiCells *cells) {
+	if (cells != NULL) {
+		free(cells->offsets);
+		free(cells->vertices);
+		free(cells);
+	}
+}
+
+/*
+ * Save the last DelaunayTriangulation status in the file.
+ * This will contains the points in the triangulation and, if success, the points
+ * forming all the lines in the triangulation.
+ *
+ * delTri:		the DelaunayTriangulation structure
+ * file_out:	the output file (already open)
+ */
+void fsaveDelaunayTriangulation(DelaunayTriangulation *delTri, FILE* file_out) {
+	DTsize n_lines_points = 2 * getDelaunayTriangulationNumberOfLines(delTri);
+
+	fprintf(file_out, "%d %d\n", getDelaunayTriangulationNumberOfPoints(delTri), n_lines_points);
+
+	DTsize i = 0;
+
+	for (i = 0; i < delTri->n_points; i++) {
+		if (POINT_DELETED(delTri, i)) continue;
+		fprintf(file_out, "%lf %lf\n", delTri->points[i][0], delTri->points[i][1]);
+	}
+
+	float (*linesPoints)[2] = malloc(sizeof(linesPoints[0]) * n_lines_points);
+	getDelaunayTriangulationLines(delTri, linesPoints, n_lines_points / 2);
+
+	for (i = 0; i < n_lines_points; i++) {
+		fprintf(file_out, "%lf %lf\n", linesPoints[i][0], linesPoints[i][1]);
+	}
+
+	if (linesPoints != NULL) free(linesPoints);
+}
+
+////////////////////////////////////////////////
+// End: DelaunayTriangulation structure utils //
+////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////
+// Begin: Edge structure utils //
+/////////////////////////////////
+
+/*
+ * Makes sure that the table of chunks can hold at least n_chunks chunks.
+ * The table is the only thing that moves when growing, so it must be large
+ * enough before multiple threads start adding edges.
+ *
+ * delTri: 		the DelaunayTriangulation structure
+ * n_chunks: 	the number of chunks that must fit in the table
+ *
+ * returns:		1 if the table is large enough, 0 otherwise (allocation failed)
+ */
+int reserveEdgeChunkTable(DelaunayTriangulation *delTri, DTsize n_chunks) {
+	if (n_chunks > delTri->n_edge_chunks_max) {
+		DTsize n_chunks_max = MIN(MAX(2 * delTri->n_edge_chunks_max, n_chunks), EDGE_CHUNK_TABLE_MAX);
+		Edge **chunks = realloc(delTri->edge_chunks, sizeof(Edge*) * n_chunks_max);
+		if (chunks == NULL) {
+			printf("ERROR: Couldn't allocate memory for edges\n");
+			return 0;
+		}
+		delTri->edge_chunks = chunks;
+#if COMPACT_EDGES
+		DTuint **flags = realloc(delTri->edge_flags, sizeof(DTuint*) * n_chunks_max);
+		if (flags == NULL) {
+			printf("ERROR: Couldn't allocate memory for edges\n");
+			return 0;
+		}
+		delTri->edge_flags = flags;
+#endif
+		delTri->n_edge_chunks_max = n_chunks_max;
+	}
+
+	return 1;
+}
+
+/*
+ * Makes sure that the DelaunayTriangulation can store at least n_edges (half)
+ * edges, allocating new chunks if needed. Chunks never move once allocated,
+ * so every edge reference remains valid.
+ *
+ * delTri: 		the DelaunayTriangulation structure
+ * n_edges: 	the number of (half) edges that must fit
+ *
+ * returns:		1 if enough edges are available, 0 otherwise (allocation failed)
+ */
+int reserveEdges(DelaunayTriangulation *delTri, DTsize n_edges) {
+	DTsize n_chunks = (DTsize) (((long) n_edges + EDGE_CHUNK_MASK) >> EDGE_CHUNK_BITS);
+
+	if (!reserveEdgeChunkTable(delTri, n_chunks)) {
+		return 0;
+	}
+
+	while (delTri->n_edge_chunks < n_chunks) {
+		Edge *chunk = malloc(sizeof(Edge) * EDGE_CHUNK_SIZE);
+		if (chunk == NULL) {
+			printf("ERROR: Couldn't allocate memory for edges\n");
+			return 0;
+		}
+#if COMPACT_EDGES
+		DTuint *flags = malloc(sizeof(DTuint) * (EDGE_CHUNK_SIZE >> 6));
+		if (flags == NULL) {
+			free(chunk);
+			printf("ERROR: Couldn't allocate memory for edges\n");
+			return 0;
+		}
+		delTri->edge_flags[delTri->n_edge_chunks] = flags;
+#endif
+		delTri->edge_chunks[delTri->n_edge_chunks] = chunk;
+		delTri->n_edge_chunks += 1;
+		delTri->n_edges_max = delTri->n_edge_chunks << EDGE_CHUNK_BITS;
+	}
+
+	return 1;
+}
+
+/*
+ * Claims a new block of EDGE_BLOCK_SIZE (half) edges for a thread during a
+ * parallel triangulation. The whole block is marked as discarded, so that the
+ * DelaunayTriangulation stays consistent whatever the thread uses from it.
+ *
+ * delTri: 		the DelaunayTriangulation structure
+ * arena: 		the arena of the thread
+ *
+ * returns:		1 if a block was claimed, 0 otherwise (allocation failed)
+ */
+int claimEdgeBlock(DelaunayTriangulation *delTri, EdgeArena *arena) {
+	DTsize start;
+	int ok;
+
+	#pragma omp critical(delaunay_edges)
+	{
+		start = delTri->n_edges;
+		ok = (delTri->n_edges_max >= start + EDGE_BLOCK_SIZE) || reserveEdges(delTri, start + EDGE_BLOCK_SIZE);
+		if (ok) delTri->n_edges += EDGE_BLOCK_SIZE;
+	}
+	if (!ok) return 0;
+
+#if COMPACT_EDGES
+	DTuint *flags = delTri->edge_flags[start >> EDGE_CHUNK_BITS];
+	for (DTsize i = start & EDGE_CHUNK_MASK; i < (start & EDGE_CHUNK_MASK) + EDGE_BLOCK_SIZE; i += 64) {
+		flags[i >> 6] = ~0u;
+	}
+#else
+	for (DTsize i = start; i < start + EDGE_BLOCK_SIZE; i += 2) {
+		Edge *e = EDGE_AT(delTri, i);
+		Edge *s = EDGE_AT(delTri, i + 1);
+		e->idx = i;
+		s->idx = i + 1;
+		e->sym = s;
+		s->sym = e;
+		e->discarded = s->discarded = 1;
+	}
+#endif
+
+	arena->next = start;
+	arena->end = start + EDGE_BLOCK_SIZE;
+	arena->n_edges_discarded += EDGE_BLOCK_SIZE;
+	return 1;
+}
+
+/*
+ * Creates a new edge in the triangulation, between two points, and returns the
+ * index at which it is stored. It will also polulate the next edge as the
+ * opposite (symetrical) edge of the one just created.
+ * A pair of previously deleted edges is reused if any, otherwise the edges
+ * are taken at the end, allocating a new chunk if needed. During a parallel
+ * triangulation, the edges are taken from the arena of the calling thread.
+ *
+ * delTri: 		the DelaunayTriangulation structure
+ * orig: 		the index of the origin point of the edge
+ * dest: 		the index of the destination point of the edge
+ *
+ * returns:		a reference to the main edge, EDGE_NULL if no memory is left
+ */
+EdgeRef addEdge(DelaunayTriangulation *delTri, DTsize orig, DTsize dest) {
+	EdgeRef e, s;
+	EdgeArena *arena = CURRENT_ARENA(delTri);
+
+	if (arena != NULL) {
+		// Parallel triangulation: the thread only takes edges from its own arena
+		if (arena->free_edges != EDGE_NULL) {
+			e = arena->free_edges;
+			arena->free_edges = ONEXT(delTri, e);
+		}
+		else {
+			if ((arena->next == arena->end) && (!claimEdgeBlock(delTri, arena))) {
+				return EDGE_NULL;
+			}
+			e = EDGE_REF(delTri, arena->next);
+			arena->next += 2;
+		}
+		s = SYM(delTri, e);
+		arena->n_edges_discarded -= 2;
+	}
+	else if (delTri->free_edges != EDGE_NULL) {
+		// Recycles a discarded pair
+		e = delTri->free_edges;
+		s = SYM(delTri, e);
+		delTri->free_edges = ONEXT(delTri, e);
+		delTri->n_edges_discarded -= 2;
+	}
+	else {
+		// Enough space ?
+		if ((delTri->n_edges_max < delTri->n_edges + 2) && (!reserveEdges(delTri, delTri->n_edges + 2))) {
+			return EDGE_NULL;
+		}
+
+		e = EDGE_REF(delTri, delTri->n_edges);
+		s = EDGE_REF(delTri, delTri->n_edges + 1);
+#if !COMPACT_EDGES
+		e->idx = delTri->n_edges;
+		s->idx = delTri->n_edges + 1;
+
+		// Bind the two edges together
+		e->sym = s;
+		s->sym = e;
+#endif
+		delTri->n_edges += 2;
+	}
+
+	SET_DISCARDED(delTri, e, 0);
+
+	// Main edge
+	ORIG(delTri, e) = orig;
 
 	// Symetrical edge
-	s =&(delTri->edges[delTri->n_edges]);
-	s->idx = delTri->n_edges;
-	delTri->n_edges += 1;
+	ORIG(delTri, s) = dest;
 
-	s->discarded = 0;
-	s->orig = dest;
+#if !COMPACT_EDGES
+	e->dest = dest;
 	s->dest = orig;
+#endif
 
-	// Bind the two edges together
-	e->sym = s;
-	s->sym = e;
+	DT_COUNT(delTri, edges_created);
 
-	e->onext = e;
-	e->oprev = e;
-	s->onext = s;
-	s->oprev = s;
+	ONEXT(delTri, e) = e;
+	OPREV(delTri, e) = e;
+	ONEXT(delTri, s) = s;
+	OPREV(delTri, s) = s;
 
-	//describeEdge(e);
+	//describeEdge(delTri, e);
 	return e;
 }
 
 /*
  * Describes an Edge structure by printing some information.
  *
- * e:			the Edge structure
+ * delTri: 		the DelaunayTriangulation structure
+ * e:			the edge
  */
-void describeEdge(Edge *e) {
+void describeEdge(DelaunayTriangulation *delTri, EdgeRef e) {
 
 	printf("Edge structure stored at %p.\n"
 		   "\t- Index:                      %d\n"
 		   "\t- Origin index:               %d\n"
 		   "\t- Destination index:          %d\n"
 		   "\t- Discarded?:                 %d\n",
-		   e,
-		   e->idx, e->orig, e->dest,
-	   	   e->discarded);
+		   (void*) EDGE_AT(delTri, EDGE_IDX(delTri, e)),
+		   EDGE_IDX(delTri, e), ORIG(delTri, e), DEST(delTri, e),
+	   	   IS_DISCARDED(delTri, e));
 }
 
 
@@ -705,18 +1472,18 @@ void describeEdge(Edge *e) {
  * a:	 		the first edge
  * b: 			the second edge
  */
-void spliceEdges(DelaunayTriangulation *delTri, Edge *a, Edge *b) {
-	if (a->idx == b->idx) {
+void spliceEdges(DelaunayTriangulation *delTri, EdgeRef a, EdgeRef b) {
+	if (EDGE_IDX(delTri, a) == EDGE_IDX(delTri, b)) {
 		return;
 	}
 
-	Edge *tmp;
-	a->onext->oprev = b;
-	b->onext->oprev = a;
+	EdgeRef tmp;
+	OPREV(delTri, ONEXT(delTri, a)) = b;
+	OPREV(delTri, ONEXT(delTri, b)) = a;
 
-	tmp = a->onext;
-	a->onext = b->onext;
-	b->onext = tmp;
+	tmp = ONEXT(delTri, a);
+	ONEXT(delTri, a) = ONEXT(delTri, b);
+	ONEXT(delTri, b) = tmp;
 }
 
 /*
@@ -727,30 +1494,99 @@ void spliceEdges(DelaunayTriangulation *delTri, Edge *a, Edge *b) {
  * a: 			the first edge
  * b: 			the second edge
  *
- * returns:		an Edge structure pointer to the new edge
+ * returns:		a reference to the new edge, EDGE_NULL if no memory is left
  */
-Edge* connectEdges(DelaunayTriangulation *delTri, Edge *a, Edge *b) {
-	Edge *e = addEdge(delTri, a->dest, b->orig);
-	spliceEdges(delTri, e, 		a->sym->oprev);
-	spliceEdges(delTri, e->sym, b);
+EdgeRef connectEdges(DelaunayTriangulation *delTri, EdgeRef a, EdgeRef b) {
+	EdgeRef e = addEdge(delTri, DEST(delTri, a), ORIG(delTri, b));
+	if (e == EDGE_NULL) return EDGE_NULL;
+	spliceEdges(delTri, e, 		OPREV(delTri, SYM(delTri, a)));
+	spliceEdges(delTri, SYM(delTri, e), b);
 	return e;
 }
 
 /*
  * Deletes an edge from the DelaunayTriangulation by discarding the edge and its
- * symetrical edge.
+ * symetrical edge. The pair is kept aside to be reused by the next addEdge.
  *
  * delTri: 		the DelaunayTriangulation structure
  * e: 			the edge
  */
-void deleteEdge(DelaunayTriangulation *delTri, Edge *e) {
-	spliceEdges(delTri, e, e->oprev);
-	spliceEdges(delTri, e->sym, e->sym->oprev);
+void deleteEdge(DelaunayTriangulation *delTri, EdgeRef e) {
+	DT_COUNT(delTri, edges_deleted);
+	spliceEdges(delTri, e, OPREV(delTri, e));
+	spliceEdges(delTri, SYM(delTri, e), OPREV(delTri, SYM(delTri, e)));
 
 	// Discard the edges from the data structure
-	e->discarded = 1;
-	e->sym->discarded = 1;
-	delTri->n_edges_discarded += 2;
+	SET_DISCARDED(delTri, e, 1);
+
+	// The pair is always linked through the edge stored first (even index)
+	if (EDGE_IDX(delTri, e) & 1) e = SYM(delTri, e);
+
+	EdgeArena *arena = CURRENT_ARENA(delTri);
+	if (arena != NULL) {
+		arena->n_edges_discarded += 2;
+		ONEXT(delTri, e) = arena->free_edges;
+		arena->free_edges = e;
+	}
+	else {
+		delTri->n_edges_discarded += 2;
+		ONEXT(delTri, e) = delTri->free_edges;
+		delTri->free_edges = e;
+	}
+}
+
+/*
+ * Flips an edge shared by two triangles, such that it connects the two other
+ * points of the quadrilateral they form. The two triangles must form a convex
+ * quadrilateral.
+ *
+ * delTri: 		the DelaunayTriangulation structure
+ * e: 			the edge
+ */
+void flipEdge(DelaunayTriangulation *delTri, EdgeRef e) {
+	// Inspired from: Guibas & Stolfi (1985), Swap procedure
+	EdgeRef a = OPREV(delTri, e);
+	EdgeRef b = OPREV(delTri, SYM(delTri, e));
+
+	spliceEdges(delTri, e, a);
+	spliceEdges(delTri, SYM(delTri, e), b);
+	spliceEdges(delTri, e, LNEXT(delTri, a));
+	spliceEdges(delTri, SYM(delTri, e), LNEXT(delTri, b));
+
+	DTsize orig = DEST(delTri, a);
+	DTsize dest = DEST(delTri, b);
+	ORIG(delTri, e) = orig;
+	ORIG(delTri, SYM(delTri, e)) = dest;
+
+#if !COMPACT_EDGES
+	e->dest = dest;
+	e->sym->dest = orig;
+#endif
+}
+
+/*
+ * Pushes an edge on the stack of edges of the DelaunayTriangulation, growing
+ * the stack if needed.
+ *
+ * delTri: 		the DelaunayTriangulation structure
+ * n_stack: 	the current number of edges in the stack, incremented
+ * e: 			the edge
+ *
+ * returns:		1 if the edge was pushed, 0 otherwise (allocation failed)
+ */
+int pushEdge(DelaunayTriangulation *delTri, DTsize *n_stack, EdgeRef e) {
+	if (*n_stack == delTri->edge_stack_max) {
+		DTsize n_max = MAX(2 * delTri->edge_stack_max, 64);
+		EdgeRef *stack = realloc(delTri->edge_stack, sizeof(EdgeRef) * n_max);
+		if (stack == NULL) {
+			printf("ERROR: Couldn't allocate memory for the stack of edges\n");
+			return 0;
+		}
+		delTri->edge_stack = stack;
+		delTri->edge_stack_max = n_max;
+	}
+	delTri->edge_stack[(*n_stack)++] = e;
+	return 1;
 }
 
 ///////////////////////////////
@@ -774,10 +1610,10 @@ void deleteEdge(DelaunayTriangulation *delTri, Edge *e) {
  */
 static int compare_points(const void *a_v, const void *b_v)
 {
-	GLfloat* a = *(GLfloat(*)[2]) a_v;
-	GLfloat* b = *(GLfloat(*)[2]) b_v;
+	DTfloat* a = *(DTfloat(*)[2]) a_v;
+	DTfloat* b = *(DTfloat(*)[2]) b_v;
 
-	GLfloat diff = a[0] - b[0];
+	DTfloat diff = a[0] - b[0];
 
 	if (diff == 0) {
 		diff = a[1] - b[1];
@@ -786,128 +1622,534 @@ static int compare_points(const void *a_v, const void *b_v)
 }
 
 /*
- * Returns the min and max x and y coordinates in the collection of points
+ * Returns 1 if the points are sorted accordingly to their x component, then
+ * their y component (same order as compare_points).
  *
  * points:		the points
  * n_points:	the number of points
- * bounds:		the preallocated array that will contain the points {min, max}
+ *
+ * returns:		1 if the points are sorted, 0 otherwise
  */
-void getPointsBoudingBox(GLfloat points[][2], GLsizei n_points, GLfloat bounds[][2]) {
-	if (n_points == 0) return;
+int pointsAreSorted(DTfloat points[][2], DTsize n_points) {
+	for (DTsize i = 1; i < n_points; i++) {
+		if ((points[i][0] < points[i - 1][0]) ||
+			((points[i][0] == points[i - 1][0]) && (points[i][1] < points[i - 1][1]))) {
+			return 0;
+		}
+	}
+	return 1;
+}
 
-	double x_min, x_max, y_min, y_max;
-	x_min = x_max = points[0][0];
-	y_min = y_max = points[0][1];
+/*
+ * Maps a float to an unsigned integer such that the order is preserved,
+ * -0 being mapped as +0.
+ */
+static inline uint32_t floatToKey(float f) {
+	uint32_t u;
+	if (f == 0) f = 0;
+	memcpy(&u, &f, sizeof(u));
+	return (u & 0x80000000u) ? ~u : (u | 0x80000000u);
+}
 
-	for (GLsizei i = 1; i < n_points; i++) {
-		x_min = MIN(points[i][0], x_min);
-		x_max = MAX(points[i][0], x_max);
-		y_min = MIN(points[i][1], y_min);
-		y_max = MAX(points[i][1], y_max);
-	}
+/*
+ * Inverse of floatToKey.
+ */
+static inline float keyToFloat(uint32_t u) {
+	float f;
+	u = (u & 0x80000000u) ? (u & 0x7fffffffu) : ~u;
+	memcpy(&f, &u, sizeof(f));
+	return f;
+}
 
-	bounds[0][0] = x_min;
-	bounds[0][1] = y_min;
-	bounds[1][0] = x_max;
-	bounds[1][1] = y_max;
+/*
+ * Interleaves the bits of two 16-bit integers, giving the position of the
+ * point (x, y) along a Morton (Z-order) curve.
+ */
+static inline uint32_t mortonKey(uint32_t x, uint32_t y) {
+	x = (x | (x << 8)) & 0x00ff00ffu;
+	x = (x | (x << 4)) & 0x0f0f0f0fu;
+	x = (x | (x << 2)) & 0x33333333u;
+	x = (x | (x << 1)) & 0x55555555u;
+	y = (y | (y << 8)) & 0x00ff00ffu;
+	y = (y | (y << 4)) & 0x0f0f0f0fu;
+	y = (y | (y << 2)) & 0x33333333u;
+	y = (y | (y << 1)) & 0x55555555u;
+	return x | (y << 1);
 }
 
 /*
- * Indicates wether a point is inside a circumscribed circle.
+ * Returns the position of the point (x, y), two 16-bit integers, along a
+ * Hilbert curve. Unlike the Morton curve, consecutive positions are always
+ * neighbors (Wikipedia, Hilbert curve, xy2d).
+ */
+static inline uint32_t hilbertKey(uint32_t x, uint32_t y) {
+	uint32_t d = 0, t;
+	for (uint32_t s = 1u << 15; s > 0; s >>= 1) {
+		uint32_t rx = (x & s) > 0;
+		uint32_t ry = (y & s) > 0;
+		d += s * s * ((3 * rx) ^ ry);
+		if (ry == 0) {
+			if (rx == 1) {
+				x = 0xffffu - x;
+				y = 0xffffu - y;
+			}
+			t = x; x = y; y = t;
+		}
+	}
+	return d;
+}
+
+/*
+ * Sorts 64-bit keys accordingly to their bits from low_bit to 63, with a least
+ * significant digit radix sort, digits shared by all the keys are skipped.
+ * If OpenMP is available, each thread counts and scatters its own slice of
+ * the keys. Keys equal on those bits keep their relative order.
  *
- * delTri:		the DelaunayTriangulation structure
- * i_p:			the index of the point
- * i_a,b,c:		the index of the points of the triangle
+ * keys:		the keys
+ * n_keys:		the number of keys
+ * low_bit:		the lowest bit to sort on
+ * n_threads:	the number of threads to use, <= 0 to use all available threads
  *
- * returns:		1 if the point lies inside the circle, 0 otherwise
+ * returns:		1 if the keys were sorted, 0 if there was not enough memory
  */
-int pointInCircle(DelaunayTriangulation *delTri, GLsizei i_p, GLsizei i_a, GLsizei i_b, GLsizei i_c) {
-    // https://www.cs.cmu.edu/~quake/robust.html
-	GLfloat *point, *a, *b, *c;
-	point = delTri->points[i_p];
-	a = delTri->points[i_a];
-	b = delTri->points[i_b];
-	c = delTri->points[i_c];
+int sortKeys(uint64_t keys[], DTsize n_keys, int low_bit, int n_threads) {
+	uint64_t *tmp;
+	DTsize (*counts)[RADIX_SIZE];
 
-#if ROBUST
-	return incircle(a, b, c, point) > 0;
+#ifdef _OPENMP
+	if (n_threads <= 0) n_threads = omp_get_max_threads();
+	n_threads = MAX(MIN(n_threads, n_keys / RADIX_THREAD_GRAIN), 1);
 #else
+	n_threads = 1;
+#endif
 
-    GLfloat a1, a2, a3, b1, b2, b3, c1, c2, c3, det;
-
-	a1 = a[0] - point[0]; a2 = a[1] - point[1];
-	b1 = b[0] - point[0]; b2 = b[1] - point[1];
-	c1 = c[0] - point[0]; c2 = c[1] - point[1];
+	tmp = malloc(sizeof(uint64_t) * n_keys);
+	counts = malloc(sizeof(counts[0]) * n_threads);
+	if ((tmp == NULL) || (counts == NULL)) {
+		if (tmp != NULL) free(tmp);
+		if (counts != NULL) free(counts);
+		return 0;
+	}
 
-	a3 = a1 * a1 + a2 * a2;
-	b3 = b1 * b1 + b2 * b2;
-	c3 = c1 * c1 + c2 * c2;
+	int skip;
 
-	det = a1*b2*c3 + a2*b3*c1 + a3*b1*c2 - (a3*b2*c1 + a1*b3*c2 + a2*b1*c3);
-    return det < 0;
+	#pragma omp parallel num_threads(n_threads)
+	{
+#ifdef _OPENMP
+		int t = omp_get_thread_num();
+#else
+		int t = 0;
 #endif
-}
-
-/*
- * Determines the center of the circumscribed circle based on triangle points.
- *
- * delTri:		the DelaunayTriangulation structure
- * i_a,b,c:		the index of the points of the triangle
- * center:		the preallocated array that will contain the center
- *
- * returns:		the diameter of the circle
- */
-GLfloat circleCenter(DelaunayTriangulation *delTri, GLsizei i_a, GLsizei i_b, GLsizei i_c, GLfloat center[2]) {
-	// https://www.codewars.com/kata/5705785658b58f387b001ffc
-	GLfloat *point, *a, *b, *c;
-	a = delTri->points[i_a];
-	b = delTri->points[i_b];
-	c = delTri->points[i_c];
-	GLfloat aa, bb, cc, dy_bc, dy_ca, dy_ab, d;
+		DTsize lo = (DTsize) (((long) n_keys * t) / n_threads);
+		DTsize hi = (DTsize) (((long) n_keys * (t + 1)) / n_threads);
+		uint64_t *src = keys, *dst = tmp, *swp;
 
-	aa = a[0] * a[0] + a[1] * a[1];
-	bb = b[0] * b[0] + b[1] * b[1];
-	cc = c[0] * c[0] + c[1] * c[1];
+		for (int shift = low_bit; shift < 64; shift += RADIX_BITS) {
+			DTsize *count = counts[t];
 
-	dy_bc = b[1] - c[1];
-	dy_ca = c[1] - a[1];
-	dy_ab = a[1] - b[1];
+			memset(count, 0, sizeof(counts[0]));
+			for (DTsize i = lo; i < hi; i++) {
+				count[(src[i] >> shift) & RADIX_MASK]++;
+			}
 
-	d = 2 * (a[0] * dy_bc + b[0] * dy_ca + c[0] * dy_ab);
+			#pragma omp barrier
+			#pragma omp single
+			{
+				// Offsets of each (digit, thread) slice, in that order
+				DTsize offset = 0, c;
+				skip = 0;
+				for (DTsize d = 0; d < RADIX_SIZE; d++) {
+					for (int u = 0; u < n_threads; u++) {
+						c = counts[u][d];
+						if (c == n_keys) skip = 1;
+						counts[u][d] = offset;
+						offset += c;
+					}
+				}
+			}
 
-	center[0] = (aa * dy_bc + bb * dy_ca + cc * dy_ab) / d;
-	// WARNING: there is an error is the link, it is Bx - Ax (and not the opposite)
-	center[1] = (aa * (c[0] - b[0]) + bb * (a[0] - c[0]) + cc * (b[0] - a[0])) / d;
+			if (!skip) {
+				for (DTsize i = lo; i < hi; i++) {
+					dst[count[(src[i] >> shift) & RADIX_MASK]++] = src[i];
+				}
+				swp = src;
+				src = dst;
+				dst = swp;
+			}
 
-	GLfloat dx, dy;
+			#pragma omp barrier
+		}
 
-	dx = a[0] - center[0];
-	dy = a[1] - center[1];
+		if (src != keys) {
+			memcpy(keys + lo, src + lo, sizeof(uint64_t) * (hi - lo));
+		}
+	}
 
-	return sqrt(dx * dx + dy * dy);
+	free(tmp);
+	free(counts);
+	return 1;
 }
 
 /*
- * Compares the position of a point relatively to an edge.
+ * Sorts points accordingly to their x component, then their y component
+ * (same order as compare_points). The (x, y) pair is mapped to a 64-bit key
+ * which is sorted with sortKeys. Points already sorted are left as is.
+ * Double precision points do not fit in such a key and are sorted with qsort,
+ * on a single thread.
  *
- * delTri:		the DelaunayTriangulation structure
- * i_p:			the index of the point
- * e:			the edge
- * returns:		the comparison (see below)
- *			1	if point is on the right
- *			0	if point is colinear with edge
- *		   -1	if point is on the left
+ * points:		the points
+ * n_points:	the number of points
+ * n_threads:	the number of threads to use, <= 0 to use all available threads
+ *				(ignored with DOUBLE_PRECISION)
  */
-int pointCompareEdge(DelaunayTriangulation *delTri, GLsizei i_p, Edge *e) {
+void sortPoints(DTfloat points[][2], DTsize n_points, int n_threads) {
+	if (pointsAreSorted(points, n_points)) {
+		return;
+	}
 
-	GLfloat *point, *orig, *dest, det;
+#if !DOUBLE_PRECISION
+	uint64_t *keys = NULL;
+
+	if (n_points >= RADIX_MIN_POINTS) {
+		keys = malloc(sizeof(uint64_t) * n_points);
+	}
+	if (keys != NULL) {
+		for (DTsize i = 0; i < n_points; i++) {
+			keys[i] = ((uint64_t) floatToKey(points[i][0]) << 32) | floatToKey(points[i][1]);
+		}
+		if (sortKeys(keys, n_points, 0, n_threads)) {
+			for (DTsize i = 0; i < n_points; i++) {
+				points[i][0] = keyToFloat((uint32_t) (keys[i] >> 32));
+				points[i][1] = keyToFloat((uint32_t) keys[i]);
+			}
+			free(keys);
+			return;
+		}
+		free(keys);
+	}
+#else
+	(void) n_threads;
+#endif
+
+	// Small number of points, or not enough memory for the radix sort
+	qsort(points, n_points, 2 * sizeof(DTfloat), compare_points);
+}
+
+/*
+ * Returns 1 if point a comes before point b along an axis: by x, then y, for
+ * the axis 0 (as compare_points), and by y, then decreasing x, for the axis 1.
+ * The latter is the order along x of the points rotated by -90 degrees, which
+ * lets mergeTriangulations (only made of orientation tests) merge halves
+ * divided horizontally.
+ */
+static inline int pointIsBefore(DTfloat a[2], DTfloat b[2], int axis) {
+	if (axis == 0) return (a[0] < b[0]) || ((a[0] == b[0]) && (a[1] < b[1]));
+	return (a[1] < b[1]) || ((a[1] == b[1]) && (a[0] > b[0]));
+}
+
+/*
+ * Returns the axis along which a slice of points is cut by ALTERNATING_CUTS:
+ * the longest side of its bounding box, so that the cells of the division
+ * stay about square (which alternates the cuts) even when the points are
+ * spread along a thin band. Small slices simply take the given axis. Only
+ * depends on the set of points, not on their order in the slice.
+ *
+ * points:		the slice of points
+ * n_points:	the number of points of the slice
+ * axis:		the axis alternating with the one of the parent slice
+ *
+ * returns:		0 to cut along x, 1 to cut along y
+ */
+static inline int getCutAxis(DTfloat points[][2], DTsize n_points, int axis) {
+	if (n_points < CUT_AXIS_MIN_POINTS) return axis;
+
+	DTfloat bounds[2][2];
+	getPointsBoudingBox(points, n_points, bounds);
+	return (bounds[1][1] - bounds[0][1] > bounds[1][0] - bounds[0][0]) ? 1 : 0;
+}
+
+/*
+ * Returns the k-th smallest of n values, which are reordered (quickselect).
+ */
+static DTfloat selectValue(DTfloat values[], DTsize n, DTsize k) {
+	DTsize lo = 0, hi = n - 1;
+	DTfloat pivot, tmp;
+
+	while (hi > lo) {
+		// Median of three pivot, so that sorted slices are not the worst case
+		DTfloat a = values[lo], b = values[lo + (hi - lo) / 2], c = values[hi];
+		if (a < b) pivot = (b < c) ? b : ((a < c) ? c : a);
+		else pivot = (a < c) ? a : ((b < c) ? c : b);
+
+		DTsize i = lo, j = hi;
+		while (i <= j) {
+			while (values[i] < pivot) i++;
+			while (pivot < values[j]) j--;
+			if (i <= j) {
+				tmp = values[i]; values[i] = values[j]; values[j] = tmp;
+				i++;
+				j--;
+			}
+		}
+		if (k <= j) hi = j;
+		else if (k >= i) lo = i;
+		else break;
+	}
+	return values[k];
+}
+
+/*
+ * Recursive function used by arrangePoints, on sorted points.
+ */
+static void arrangeSlice(DTfloat points[][2], DTfloat tmp[][2], DTsize n_points, DTsize leaf_size, int axis) {
+	if (n_points <= leaf_size) return;
+
+	DTsize m = (n_points + 1) / 2;
+	axis = getCutAxis(points, n_points, axis);
+	if (axis == 1) {
+		// The first half are the m lowest points (see pointIsBefore), both halves stay sorted by x
+		DTfloat *y = (DTfloat*) tmp;
+		for (DTsize i = 0; i < n_points; i++) {
+			y[i] = points[i][1];
+		}
+		DTfloat y_m = selectValue(y, n_points, m - 1);
+
+		// Among the points at y_m, the last ones (largest x) are the lowest
+		DTsize n_below = 0, n_at = 0;
+		for (DTsize i = 0; i < n_points; i++) {
+			n_below += (points[i][1] < y_m);
+			n_at += (points[i][1] == y_m);
+		}
+		DTsize skip = n_at - (m - n_below);
+
+		DTsize l = 0, r = m;
+		for (DTsize i = 0; i < n_points; i++) {
+			int low = (points[i][1] < y_m);
+			if (points[i][1] == y_m) low = (skip-- <= 0);
+			DTsize j = low ? l++ : r++;
+			tmp[j][0] = points[i][0];
+			tmp[j][1] = points[i][1];
+		}
+		memcpy(points, tmp, sizeof(tmp[0]) * n_points);
+	}
+
+	if (n_points > PARALLEL_GRAIN) {
+		#pragma omp task default(shared)
+		arrangeSlice(points, tmp, m, leaf_size, 1 - axis);
+
+		arrangeSlice(points + m, tmp + m, n_points - m, leaf_size, 1 - axis);
+
+		#pragma omp taskwait
+	}
+	else {
+		arrangeSlice(points, 		tmp, 		m, 				leaf_size, 1 - axis);
+		arrangeSlice(points + m, 	tmp + m, 	n_points - m, 	leaf_size, 1 - axis);
+	}
+}
+
+/*
+ * Arranges sorted points (see sortPoints) for the alternating cuts of
+ * triangulateBottomUp: a slice of points is halved as triangulate does, its
+ * first half being the points before the other along the axis given by
+ * getCutAxis (see pointIsBefore). Slices stay sorted by x, so that halving
+ * along x and the leaves (see triangulateLeaf) need no work.
+ *
+ * points:		the points, sorted
+ * n_points:	the number of points
+ * leaf_size:	the largest number of points of a leaf, which is not halved (see delTri->leaf_size)
+ * n_threads:	the number of threads to use, <= 0 to use all available threads
+ *
+ * returns:		1 if the points were arranged, 0 if there was not enough memory
+ */
+int arrangePoints(DTfloat points[][2], DTsize n_points, DTsize leaf_size, int n_threads) {
+	DTfloat (*tmp)[2] = malloc(sizeof(tmp[0]) * MAX(n_points, 1));
+	if (tmp == NULL) {
+		return 0;
+	}
+
+#ifdef _OPENMP
+	if (n_threads <= 0) n_threads = omp_get_max_threads();
+#else
+	n_threads = 1;
+#endif
+
+	// Halves of more than PARALLEL_GRAIN points are arranged as separate tasks
+	#pragma omp parallel num_threads(n_threads) if ((n_threads > 1) && (n_points > PARALLEL_GRAIN))
+	#pragma omp single
+	arrangeSlice(points, tmp, n_points, leaf_size, 0);
+
+	free(tmp);
+	return 1;
+}
+
+/*
+ * Returns the min and max x and y coordinates in the collection of points
+ *
+ * points:		the points
+ * n_points:	the number of points
+ * bounds:		the preallocated array that will contain the points {min, max}, zeros if there is no point
+ */
+void getPointsBoudingBox(DTfloat points[][2], DTsize n_points, DTfloat bounds[][2]) {
+	if (n_points == 0) {
+		bounds[0][0] = bounds[0][1] = bounds[1][0] = bounds[1][1] = 0;
+		return;
+	}
+
+	double x_min, x_max, y_min, y_max;
+	x_min = y_min = INFINITY;
+	x_max = y_max = -INFINITY;
+
+	for (DTsize i = 0; i < n_points; i++) {
+		if (isnan(points[i][0])) continue; // Deleted point
+		x_min = MIN(points[i][0], x_min);
+		x_max = MAX(points[i][0], x_max);
+		y_min = MIN(points[i][1], y_min);
+		y_max = MAX(points[i][1], y_max);
+	}
+
+	bounds[0][0] = x_min;
+	bounds[0][1] = y_min;
+	bounds[1][0] = x_max;
+	bounds[1][1] = y_max;
+}
+
+/*
+ * Same as orient2d (positive if a, b, c are counterclockwise), but the
+ * determinant is first evaluated in double precision: its sign is kept when
+ * it is larger than the bound on the rounding error, which almost always
+ * happens for float coordinates. Otherwise, the adaptive (and exact if
+ * needed) routine of predicates.c is used.
+ */
+static inline double orient2dFiltered(DelaunayTriangulation *delTri, DTfloat *a, DTfloat *b, DTfloat *c) {
+	double detleft = ((double) a[0] - c[0]) * ((double) b[1] - c[1]);
+	double detright = ((double) a[1] - c[1]) * ((double) b[0] - c[0]);
+	double det = detleft - detright;
+	double errbound = ORIENT2D_FILTER_BOUND * (fabs(detleft) + fabs(detright));
+
+	if ((det >= errbound) || (-det >= errbound)) {
+		COUNT_PREDICATE(orient2d_stats, PREDICATE_FILTER);
+		return det;
+	}
+	COUNT_PREDICATE(orient2d_stats, PREDICATE_ADAPTIVE);
+	DT_COUNT(delTri, orient2d_exact);
+	return orient2d(a, b, c);
+}
+
+/*
+ * Same as incircle (positive if d is inside the circle of the counterclockwise
+ * triangle a, b, c), with the same filter as orient2dFiltered.
+ */
+static inline double incircleFiltered(DelaunayTriangulation *delTri, DTfloat *a, DTfloat *b, DTfloat *c, DTfloat *d) {
+	double adx = (double) a[0] - d[0], ady = (double) a[1] - d[1];
+	double bdx = (double) b[0] - d[0], bdy = (double) b[1] - d[1];
+	double cdx = (double) c[0] - d[0], cdy = (double) c[1] - d[1];
+
+	double bdxcdy = bdx * cdy, cdxbdy = cdx * bdy, alift = adx * adx + ady * ady;
+	double cdxady = cdx * ady, adxcdy = adx * cdy, blift = bdx * bdx + bdy * bdy;
+	double adxbdy = adx * bdy, bdxady = bdx * ady, clift = cdx * cdx + cdy * cdy;
+
+	double det = alift * (bdxcdy - cdxbdy) + blift * (cdxady - adxcdy) + clift * (adxbdy - bdxady);
+	double permanent = (fabs(bdxcdy) + fabs(cdxbdy)) * alift
+					 + (fabs(cdxady) + fabs(adxcdy)) * blift
+					 + (fabs(adxbdy) + fabs(bdxady)) * clift;
+	double errbound = INCIRCLE_FILTER_BOUND * permanent;
+
+	if ((det > errbound) || (-det > errbound)) {
+		COUNT_PREDICATE(incircle_stats, PREDICATE_FILTER);
+		return det;
+	}
+	COUNT_PREDICATE(incircle_stats, PREDICATE_ADAPTIVE);
+	DT_COUNT(delTri, incircle_exact);
+	return incircle(a, b, c, d);
+}
+
+/*
+ * Indicates wether a point is inside a circumscribed circle.
+ *
+ * delTri:		the DelaunayTriangulation structure
+ * i_p:			the index of the point
+ * i_a,b,c:		the index of the points of the triangle
+ *
+ * returns:		1 if the point lies inside the circle, 0 otherwise
+ */
+int pointInCircle(DelaunayTriangulation *delTri, DTsize i_p, DTsize i_a, DTsize i_b, DTsize i_c) {
+    // https://www.cs.cmu.edu/~quake/robust.html
+	DTfloat *point, *a, *b, *c;
 	point = delTri->points[i_p];
-	orig = delTri->points[e->orig];
-	dest = delTri->points[e->dest];
+	a = delTri->points[i_a];
+	b = delTri->points[i_b];
+	c = delTri->points[i_c];
+	DT_COUNT(delTri, incircle_calls);
+
+#if ROBUST
+	return incircleFiltered(delTri, a, b, c, point) > 0;
+#else
+
+    DTfloat a1, a2, a3, b1, b2, b3, c1, c2, c3, det;
+
+	a1 = a[0] - point[0]; a2 = a[1] - point[1];
+	b1 = b[0] - point[0]; b2 = b[1] - point[1];
+	c1 = c[0] - point[0]; c2 = c[1] - point[1];
+
+	a3 = a1 * a1 + a2 * a2;
+	b3 = b1 * b1 + b2 * b2;
+	c3 = c1 * c1 + c2 * c2;
+
+	det = a1*b2*c3 + a2*b3*c1 + a3*b1*c2 - (a3*b2*c1 + a1*b3*c2 + a2*b1*c3);
+    return det < 0;
+#endif
+}
+
+/*
+ * Determines the center of the circumscribed circle based on triangle points.
+ *
+ * delTri:		the DelaunayTriangulation structure
+ * i_a,b,c:		the index of the points of the triangle
+ * center:		the preallocated array that will contain the center
+ *
+ * returns:		the diameter of the circle
+ */
+float circleCenter(DelaunayTriangulation *delTri, DTsize i_a, DTsize i_b, DTsize i_c, float center[2]) {
+	// https://www.codewars.com/kata/5705785658b58f387b001ffc
+	DTfloat *point, *a, *b, *c;
+	a = delTri->points[i_a];
+	b = delTri->points[i_b];
+	c = delTri->points[i_c];
+	DTfloat aa, bb, cc, dy_bc, dy_ca, dy_ab, d;
+
+	aa = a[0] * a[0] + a[1] * a[1];
+	bb = b[0] * b[0] + b[1] * b[1];
+	cc = c[0] * c[0] + c[1] * c[1];
+
+	dy_bc = b[1] - c[1];
+	dy_ca = c[1] - a[1];
+	dy_ab = a[1] - b[1];
+
+	d = 2 * (a[0] * dy_bc + b[0] * dy_ca + c[0] * dy_ab);
+
+	center[0] = (aa * dy_bc + bb * dy_ca + cc * dy_ab) / d;
+	// WARNING: there is an error is the link, it is Bx - Ax (and not the opposite)
+	center[1] = (aa * (c[0] - b[0]) + bb * (a[0] - c[0]) + cc * (b[0] - a[0])) / d;
+
+	float dx, dy;
+
+	dx = a[0] - center[0];
+	dy = a[1] - center[1];
+
+	return sqrt(dx * dx + dy * dy);
+}
+
+/*
+ * Compares the position of a point relatively to the segment from orig to
+ * dest, as pointCompareEdge does for an edge.
+ */
+static inline int coordsCompareSegment(DelaunayTriangulation *delTri, DTfloat point[2], DTfloat orig[2], DTfloat dest[2]) {
+	DTfloat det;
+	DT_COUNT(delTri, orient2d_calls);
 
 #if ROBUST
 
-	det = -orient2d(orig, dest, point);
+	det = -orient2dFiltered(delTri, orig, dest, point);
 
 #else
 
@@ -918,6 +2160,35 @@ int pointCompareEdge(DelaunayTriangulation *delTri, GLsizei i_p, Edge *e) {
 	return (det>0) - (det<0);
 }
 
+/*
+ * Compares the position of a point relatively to an edge.
+ *
+ * delTri:		the DelaunayTriangulation structure
+ * i_p:			the index of the point
+ * e:			the edge
+ * returns:		the comparison (see below)
+ *			1	if point is on the right
+ *			0	if point is colinear with edge
+ *		   -1	if point is on the left
+ */
+int pointCompareEdge(DelaunayTriangulation *delTri, DTsize i_p, EdgeRef e) {
+	return coordsCompareEdge(delTri, delTri->points[i_p], e);
+}
+
+/*
+ * Compares the position of a point, given by its coordinates, relatively to an
+ * edge. Same as pointCompareEdge, but the point needs not be in the
+ * DelaunayTriangulation.
+ *
+ * delTri:		the DelaunayTriangulation structure
+ * point:		the point (x, y)
+ * e:			the edge
+ * returns:		1 if point is on the right, 0 if colinear, -1 if on the left
+ */
+int coordsCompareEdge(DelaunayTriangulation *delTri, DTfloat point[2], EdgeRef e) {
+	return coordsCompareSegment(delTri, point, delTri->points[ORIG(delTri, e)], delTri->points[DEST(delTri, e)]);
+}
+
 /*
  * Computes the angle between to contiguous edges.
  *
@@ -926,18 +2197,18 @@ int pointCompareEdge(DelaunayTriangulation *delTri, GLsizei i_p, Edge *e) {
  * f:			the second edge (with f->dest == e->dest)
  * returns:		the angle
  */
-GLfloat angleBetweenContiguousEdges(DelaunayTriangulation *delTri, Edge *e, Edge *f) {
+float angleBetweenContiguousEdges(DelaunayTriangulation *delTri, EdgeRef e, EdgeRef f) {
 	// https://www.omnicalculator.com/math/angle-between-two-vectors
-	GLfloat *point, *a, *b, *c;
-	GLfloat xa, xb, xc, ya, yb, yc;
-	a = delTri->points[e->orig];
-	b = delTri->points[e->dest];
-	c = delTri->points[f->orig];
+	DTfloat *point, *a, *b, *c;
+	float xa, xb, xc, ya, yb, yc;
+	a = delTri->points[ORIG(delTri, e)];
+	b = delTri->points[DEST(delTri, e)];
+	c = delTri->points[ORIG(delTri, f)];
 
 	xa = a[0]; xb = b[0]; xc = c[0];
 	ya = a[1]; yb = b[1]; yc = c[1];
 
-	GLfloat dx_e, dx_f, dy_e, dy_f;
+	float dx_e, dx_f, dy_e, dy_f;
 
 	dx_e = xb - xa; dx_f = xc - xb;
 	dy_e = yb - ya; dy_f = yc - yb;
@@ -955,27 +2226,184 @@ GLfloat angleBetweenContiguousEdges(DelaunayTriangulation *delTri, Edge *e, Edge
 // Begin: Triangulation functions //
 ////////////////////////////////////
 
+/*
+ * Returns delTri->leaf_size, clamped between 3 and LEAF_SIZE_MAX.
+ */
+static inline DTsize getLeafSize(DelaunayTriangulation *delTri) {
+	return MIN(MAX(delTri->leaf_size, 3), LEAF_SIZE_MAX);
+}
+
+/*
+ * Orders the points as the divide and conquer of delTri->cuts expects them:
+ * sorted (x, then y) for X_CUTS, arranged (see arrangePoints) for
+ * ALTERNATING_CUTS. Nothing is done if they already are.
+ *
+ * delTri: 		the DelaunayTriangulation structure
+ * n_threads: 	the number of threads used to sort (and arrange) the points, <= 0 to use all available threads
+ *
+ * returns:		1 if the points are ready, 0 if there was not enough memory to arrange them
+ */
+int preparePoints(DelaunayTriangulation *delTri, int n_threads) {
+	if ((delTri->cuts == ALTERNATING_CUTS) ? (delTri->arranged == getLeafSize(delTri)) : delTri->sorted) {
+		return 1;
+	}
+
+	// Sort points by x coordinates then by y coordinate.
+	if (!delTri->sorted) {
+		sortPoints(delTri->points, delTri->n_points, n_threads);
+		delTri->sorted = 1;
+		delTri->arranged = 0;
+		delTri->grid_nx = delTri->grid_ny = 0;
+	}
+
+	if (delTri->cuts == ALTERNATING_CUTS) {
+		if (!arrangePoints(delTri->points, delTri->n_points, getLeafSize(delTri), n_threads)) {
+			printf("ERROR: Couldn't allocate memory to arrange the points\n");
+			return 0;
+		}
+		delTri->sorted = 0;
+		delTri->arranged = getLeafSize(delTri);
+	}
+	return 1;
+}
+
 /*
  * Triangulates a set of points using the DelaunayTriangulation.
  * This function should be the main function which will all the other sub-functions.
+ * The points are divided by x only, or alternately by x and y if delTri->cuts
+ * is ALTERNATING_CUTS (see triangulateBottomUp).
  *
  * delTri: 		the DelaunayTriangulation structure
+ *
+ * returns:		1 if the triangulation was computed, 0 otherwise (not enough memory for edges)
  */
-void triangulateDT(DelaunayTriangulation *delTri) {
+int triangulateDT(DelaunayTriangulation *delTri) {
 	if (delTri->success) {
-		return;
+		return 1;
 	}
+	compactPoints(delTri);
 	if (delTri->n_points < 2) {
-		return;
+		return 0;
 	}
 
-	// Sort points by x coordinates then by y coordinate.
-	qsort(delTri->points, delTri->n_points, 2 * sizeof(GLfloat), compare_points);
+	if (!preparePoints(delTri, 0)) {
+		return 0;
+	}
 
 	/// Starts the triangulation using a divide and conquer approach.
-	Edge *l, *r;
-	triangulate(delTri, 0, delTri->n_points, &l, &r);
+	EdgeRef l, r;
+	if (!triangulateBottomUp(delTri, 1, &l, &r)) {
+		printf("ERROR: Triangulation aborted, not enough memory\n");
+		resetDelaunayTriangulation(delTri);
+		return 0;
+	}
+	delTri->hint = l;
 	delTri->success = 1;
+	delTri->version++;
+#if DT_STATS
+	delTri->stats.max_depth = getRecursionDepth(delTri->n_points, getLeafSize(delTri));
+#endif
+	return 1;
+}
+
+/*
+ * Triangulates a set of points using the DelaunayTriangulation, like
+ * triangulateDT, but the subtrees of the divide and conquer, then the merges
+ * of each level above them, are shared between (OpenMP) threads (see
+ * triangulateBottomUp). Each thread takes its edges from its own arena, so the
+ * result is the same as triangulateDT.
+ * Without OpenMP, this is equivalent to triangulateDT.
+ *
+ * delTri: 		the DelaunayTriangulation structure
+ * n_threads: 	the number of threads to use, <= 0 to use all available threads
+ * grain: 		the number of points below which the points are triangulated sequentially,
+ * 				<= 0 to use PARALLEL_GRAIN
+ *
+ * returns:		1 if the triangulation was computed, 0 otherwise (not enough memory for edges)
+ */
+int triangulateDTParallel(DelaunayTriangulation *delTri, int n_threads, DTsize grain) {
+	if (delTri->success) {
+		return 1;
+	}
+	compactPoints(delTri);
+	if (delTri->n_points < 2) {
+		return 0;
+	}
+
+#ifdef _OPENMP
+	if (n_threads <= 0) n_threads = omp_get_max_threads();
+#else
+	n_threads = 1;
+#endif
+	if (grain <= 0) grain = PARALLEL_GRAIN;
+
+	if ((n_threads == 1) || (delTri->n_points <= grain)) {
+		return triangulateDT(delTri);
+	}
+
+	if (!preparePoints(delTri, n_threads)) {
+		return 0;
+	}
+
+	// A triangulation has at most 3n edges, blocks and chunks are allocated
+	// upfront so that threads rarely need to allocate memory. The chunk table
+	// must never move while threads are running.
+	int ok = reserveEdgeChunkTable(delTri, EDGE_CHUNK_TABLE_MAX) &&
+			 reserveEdges(delTri, 6 * delTri->n_points + 2 * n_threads * EDGE_BLOCK_SIZE);
+
+	delTri->arenas = calloc(n_threads, sizeof(EdgeArena));
+	if (delTri->arenas == NULL) ok = 0;
+
+	if (ok) {
+		for (int t = 0; t < n_threads; t++) {
+			delTri->arenas[t].next = 0;
+			delTri->arenas[t].end = 0;
+			delTri->arenas[t].n_edges_discarded = 0;
+			delTri->arenas[t].free_edges = EDGE_NULL;
+		}
+
+		EdgeRef l, r;
+		ok = triangulateBottomUp(delTri, n_threads, &l, &r);
+
+		delTri->hint = l;
+	}
+
+	if (!ok) {
+		printf("ERROR: Triangulation aborted, not enough memory\n");
+		if (delTri->arenas != NULL) free(delTri->arenas);
+		delTri->arenas = NULL;
+		resetDelaunayTriangulation(delTri);
+		return 0;
+	}
+
+	// Gives back to the DelaunayTriangulation all the edges left in the arenas
+	EdgeArena *arenas = delTri->arenas;
+	delTri->arenas = NULL;
+
+	for (int t = 0; t < n_threads; t++) {
+		EdgeRef e;
+		delTri->n_edges_discarded += arenas[t].n_edges_discarded;
+
+		while (arenas[t].free_edges != EDGE_NULL) {
+			e = arenas[t].free_edges;
+			arenas[t].free_edges = ONEXT(delTri, e);
+			ONEXT(delTri, e) = delTri->free_edges;
+			delTri->free_edges = e;
+		}
+		for (DTsize i = arenas[t].next; i < arenas[t].end; i += 2) {
+			e = EDGE_REF(delTri, i);
+			ONEXT(delTri, e) = delTri->free_edges;
+			delTri->free_edges = e;
+		}
+	}
+	free(arenas);
+
+	delTri->success = 1;
+	delTri->version++;
+#if DT_STATS
+	delTri->stats.max_depth = getRecursionDepth(delTri->n_points, getLeafSize(delTri));
+#endif
+	return 1;
 }
 
 /*
@@ -988,1039 +2416,1226 @@ void triangulateDT(DelaunayTriangulation *delTri) {
  * el:			an Edge structure pointer for the left edge
  * er:			an Edge structure pointer for the right edge
  *
+ * returns:		1 on success, 0 if an edge could not be allocated
  */
-void triangulate(DelaunayTriangulation *delTri, GLsizei start, GLsizei end, Edge **el, Edge **er) {
-	GLsizei n = end - start;
+int triangulate(DelaunayTriangulation *delTri, DTsize start, DTsize end, EdgeRef *el, EdgeRef *er) {
+	DTsize n = end - start;
 	if (n == 2) {
 		// Creates an edge connecting the two points (start), (start + 1)
-		Edge *e = addEdge(delTri, start, start + 1);
+		EdgeRef e = addEdge(delTri, start, start + 1);
+		if (e == EDGE_NULL) return 0;
 		*el = e;
-		*er = e->sym;
-		return;
+		*er = SYM(delTri, e);
+		return 1;
 	}
 	else if (n == 3) {
-		Edge *a, *b, *c;
+		EdgeRef a, b, c;
 
 		// Creates two edges
 		// - a, connecting (start), 	(start + 1)
 		// - b, connecting (start + 1), (start + 2)
 		a = addEdge(delTri, start, 		start + 1);
 		b = addEdge(delTri, start + 1, 	start + 2);
-		spliceEdges(delTri, a->sym, b);
+		if ((a == EDGE_NULL) || (b == EDGE_NULL)) return 0;
+		spliceEdges(delTri, SYM(delTri, a), b);
 
 		int cmp = pointCompareEdge(delTri, start + 2, a);
 
 		// Now will close the triangle formed by the three points
 		if (cmp == 1) {
 			c = connectEdges(delTri, b, a);
+			if (c == EDGE_NULL) return 0;
 			*el = a;
-			*er = b->sym;
-			return;
+			*er = SYM(delTri, b);
+			return 1;
 		}
 		else if (cmp == -1) {
 			c = connectEdges(delTri, b, a);
-			*el = c->sym;
+			if (c == EDGE_NULL) return 0;
+			*el = SYM(delTri, c);
 			*er = c;
-			return;
+			return 1;
 		}
 		else {
 			*el = a;
-			*er = b->sym;
-			return;
+			*er = SYM(delTri, b);
+			return 1;
 		}
 	}
+	else if (n <= getLeafSize(delTri)) {
+		return triangulateLeaf(delTri, start, end, el, er);
+	}
 	else {
 		// Recusively calls this function on half the points
-		GLsizei m = (n + 1) / 2;
-		Edge *ldo, *ldi, *rdi, *rdo;
-		triangulate(delTri, start, 		start + m, 	&ldo, &ldi);
-		triangulate(delTri, start + m, 	end, 		&rdi, &rdo);
-
-		// Computes the upper common tangent of left and right edges
-		while (1) {
-			if 		(pointCompareEdge(delTri, rdi->orig, ldi) ==  1) {
-				ldi = ldi->sym->onext;
-			}
-			else if (pointCompareEdge(delTri, ldi->orig, rdi) == -1) {
-				rdi = rdi->sym->oprev;
-			}
-			else {
-				break;
-			}
-		}
+		DTsize m = (n + 1) / 2;
+		EdgeRef ldo, ldi, rdi, rdo;
+		if (!triangulate(delTri, start, 		start + m, 	&ldo, &ldi)) return 0;
+		if (!triangulate(delTri, start + m, 	end, 		&rdi, &rdo)) return 0;
 
-		Edge *base;
-
-		// Creates an edge between rdi.orig and ldi.orig
-		base = connectEdges(delTri, ldi->sym, rdi);
-
-		// Ajdusts ldo and rdo
-		if (ldi->orig == ldo->orig) {
-			ldo = base;
-		}
-		if (rdi->orig == rdo->orig) {
-			rdo = base->sym;
-		}
-
-		Edge *lcand, *rcand, *tmp;
-		int v_rcand, v_lcand;
-
-		// We merge both parts
-		while (1) {
-			// Locates the first right and left points to be encountered
-			// by the diving bubble
-
-			rcand = base->sym->onext;
-			lcand = base->oprev;
-
-			v_rcand = (pointCompareEdge(delTri, rcand->dest, base) == 1);
-			v_lcand = (pointCompareEdge(delTri, lcand->dest, base) == 1);
-			if (!(v_rcand || v_lcand)) {
-				// Merge is done
-				break;
-			}
-			// Deletes right edges that fail the circle test
-			if (v_rcand) {
-				while ((pointCompareEdge(delTri, rcand->onext->dest, base) == 1) &&
-					   (pointInCircle(delTri, rcand->onext->dest, base->dest, base->orig, rcand->dest))
-				   )
-					   {
-						   tmp = rcand->onext;
-						   deleteEdge(delTri, rcand);
-						   rcand = tmp;
-					   }
-			}
-			// Deletes left edges that fail the circle test
-			if (v_lcand) {
-				while ((pointCompareEdge(delTri, lcand->oprev->dest, base) == 1) &&
-					   (pointInCircle(delTri, lcand->oprev->dest, base->dest, base->orig, lcand->dest))
-				   )
-					   {
-						   tmp = lcand->oprev;
-						   deleteEdge(delTri, lcand);
-						   lcand = tmp;
-					   }
-			}
-
-			if ((!v_rcand) ||
-				(v_rcand && pointInCircle(delTri, lcand->dest, rcand->dest, rcand->orig, lcand->orig))
-			) {
-
-				tmp = connectEdges(delTri, lcand, base->sym);
-				base = tmp;
-			}
-			else {
-				tmp = connectEdges(delTri, base->sym, rcand->sym);
-				base = tmp;
-			}
-		}
-
-		*el = ldo;
-		*er = rdo;
+		return mergeTriangulations(delTri, ldo, ldi, rdi, rdo, el, er);
 	}
 }
 
-//////////////////////////////////
-// End: Triangulation functions //
-//////////////////////////////////
-
-////////////////////////////////////////////////////////////////////////////////
-
-//////////////////////////////
-// Begin: Drawing functions //
-//////////////////////////////
-
 /*
- * Returns the position of the mouse in the x, y coordinates.
- *
- * window:		the window
- * mouse_pos:	the preallocated array that will contain the position
+ * Adds a pair of edges to a leaf, as addEdge does.
  */
-void getMousePosition(bov_window_t *window, GLfloat mouse_pos[2]) {
-	mouse_pos[0] = (window->cursorPos[0] - window->param.translate[0]);
-	mouse_pos[1] = (window->cursorPos[1] - window->param.translate[1]);
+static inline int addLeafEdge(LeafEdges *leaf, int orig, int dest) {
+	int e = leaf->n_edges;
+	leaf->n_edges += 2;
+	leaf->orig[e] = orig;
+	leaf->orig[e ^ 1] = dest;
+	leaf->onext[e] = leaf->oprev[e] = e;
+	leaf->onext[e ^ 1] = leaf->oprev[e ^ 1] = e ^ 1;
+	return e;
 }
 
 /*
- * Fills the information text with some data.
- *
- * delTri:			the DelaunayTriangulation structure
- * info_text_char:	the preallocated array that will contain the text
+ * Combines two distinct edges of a leaf, as spliceEdges does.
  */
-void getInfoText(DelaunayTriangulation *delTri, char *info_text_char) {
-	sprintf(info_text_char, "Number of points: %7d / Smallest angle : %2.2f\xba", delTri->n_points, RAD2DEG(getSmallestAngle(delTri)));
+static inline void spliceLeafEdges(LeafEdges *leaf, int a, int b) {
+	if (a == b) return;
+
+	int tmp = leaf->onext[a];
+	leaf->oprev[leaf->onext[a]] = b;
+	leaf->oprev[leaf->onext[b]] = a;
+	leaf->onext[a] = leaf->onext[b];
+	leaf->onext[b] = tmp;
 }
 
 /*
- * Provides quite a few tools to visualize the DelaunayTriangulation.
- *
- * delTri:		the DelaunayTriangulation structure
- * window:		the window
- * total_time:	the total time the animation should approximatively last
- */
-void drawDelaunayTriangulation(DelaunayTriangulation *delTri, bov_window_t *window, double total_time) {
-	// Information text
-	bov_text_t* text = bov_text_new(
-		(GLubyte[]) {"This plot is interactive!\n"
-		             "\xf8 Press [A/D] to add/delete a point nearby your cursor\n"
-					 "\xee Hold [SHIFT] while pressing [A/D] to repeat\n"
-					 "\xf8 Hold  [S]   to select a point nearby your cursor and\n"
-					 "              change its location\n"
-					 "\xf8 Press [O]   to show/hide points\n"
-					 "\xf8 Press [L]   to show/hide triangulation lines\n"
-					 "\xf8 Press [V]   to show/hide Voronoi diagram\n"
-		             "\xf8 Press [F]   to switch between fast and pretty drawing\n"
-					 "\xf8 Press [I]   to illustrate each step of the triangulation\n"
-					 "\xf8 Press [G]   to show/hide the SMallest Angle Game rules\n"
-				     "\xf8 Press [X]   to show/hide this text\n"
-				     "\xf8 Press [H]   to show/hide the default help menu\n\n"
-				 	 "\x8a Features using DRAG & DROP may not work correctly\n"
-					 "with a trackpad: please use a mouse."},
-		GL_STATIC_DRAW);
-	bov_text_set_space_type(text, PIXEL_SPACE);
-	bov_text_param_t text_parameters = bov_text_get_param(text);
-	text_parameters.fontSize *= .7;
-	bov_text_set_param(text, text_parameters);
-
-	GLubyte info_text_char[200] = {""};
-
-	getInfoText(delTri, info_text_char);
-
-	bov_text_t* info_text = bov_text_new(info_text_char, GL_STATIC_DRAW);
-	bov_text_set_space_type(info_text, PIXEL_SPACE);
-
-	// Game rules
-	bov_text_t* rules = bov_text_new(
-		(GLubyte[]) {"\t\t\t\t\tPlay the SMallest Angle Game (SMAG) !\n"
-		 			 "\n"
-					 "Delaunay triangulation is used because it maximises the smallest angle.\n"
-					 "\n"
-					 "Here are the rules:\n"
-					 "\n"
-		             "\t1. Choose a minimum angle you should never be lower than (eg.: 5\xba)\n"
-		             "\t2. Delete all the points or restart with -n 0 flag\n"
-					 "\t3. Try to add new points while staying above the minimum angle\n"
-					 "\t4. When you break the limit, the game is over!\n"
-					 "\t   Record the # of points you reached and challenge you friends to do better\n"
-					 "\n"
-					 "Alternatively, you can play with friends on the same computer, and\n"
-					 "the one who first breaks the limit loses the game."},
-		GL_STATIC_DRAW);
-	bov_text_set_space_type(rules, PIXEL_SPACE);
-	bov_text_param_t rules_parameters = bov_text_get_param(rules);
-	rules_parameters.fontSize *= .7;
-	bov_text_set_param(rules, rules_parameters);
-
-	// Points
-    bov_points_t *pointsDraw = bov_points_new(delTri->points, delTri->n_points, GL_STATIC_DRAW);
-	bov_points_set_color(pointsDraw, BASIC_POINTS_COLOR);
-	bov_points_set_outline_color(pointsDraw, BASIC_POINTS_OUTLINE_COLOR);
-	bov_points_set_width(pointsDraw, BASIC_POINTS_WIDTH);
-
-	GLfloat bounds[][2] = {{0.0, 0.0}, {0.0, 0.0}};
-
-	// Lines (edges)
-	GLsizei n_lines = 0;
-	GLfloat (*linesPoints)[2] = NULL;
-	bov_points_t *linesDraw = bov_points_new(linesPoints, n_lines, GL_STATIC_DRAW);
-	bov_points_set_color(linesDraw, TRIANGULATION_LINES_COLOR);
-	bov_points_set_width(linesDraw, TRIANGULATION_LINES_WIDTH);
-	bov_points_set_outline_color(linesDraw, TRIANGULATION_LINES_OUTLINE_COLOR);
-	bov_points_set_outline_width(linesDraw, 0.5 * TRIANGULATION_LINES_WIDTH);
-
-	// If DelaunayTriangulation was computed, will display it
-	if (delTri->success) {
-		n_lines = getDelaunayTriangulationNumberOfLines(delTri);
-		linesPoints = malloc(sizeof(linesPoints[0]) * 2 * n_lines);
-		getDelaunayTriangulationLines(delTri, linesPoints, n_lines);
-		bov_points_update(linesDraw, linesPoints, 2 * n_lines);
-	}
-
-	// Some key bindings
-	// WARNING: here, I suppose you have an AZERTY layout
-	int FAST = (delTri->n_points > 100);
-	int VORONOI = 0;
-	int REQUIRE_UPDATE = 0;
-	int HIDE_TEXT = 0;
-	int SHOW_POINTS = 1;
-	int SHOW_LINES = 1;
-	int SHOW_GAME_RULES = 0;
-	int ILLUSTRATE = 0;
-	int KEY_A, KEY_D, KEY_S, KEY_F, KEY_V, KEY_X, KEY_O, KEY_L, KEY_I, KEY_G;
-	int KEY_SHIFT;
-	int LAST_KEY_A, LAST_KEY_D, LAST_KEY_F, LAST_KEY_V, LAST_KEY_X, LAST_KEY_O, LAST_KEY_L, LAST_KEY_I, LAST_KEY_G;
-	LAST_KEY_A = LAST_KEY_D = LAST_KEY_F = LAST_KEY_V = LAST_KEY_X = LAST_KEY_O = LAST_KEY_L = LAST_KEY_I = LAST_KEY_G = 0;
-
-	int idx = -1;
-
-	// Mouse
-	GLfloat mousePoint[][2] = {{0.0, 0.0}};
-	bov_points_t *mouseDraw = bov_points_new(mousePoint, 1, GL_STATIC_DRAW);
-	bov_points_set_color(mouseDraw, MOUSE_POINTS_COLOR);
-	bov_points_set_outline_color(mouseDraw, MOUSE_POINTS_OUTLINE_COLOR);
-	bov_points_set_width(mouseDraw, MOUSE_POINTS_WIDTH);
-	bov_points_set_outline_width(mouseDraw, -.1);
-
-	// Voronoi
-	GLsizei n_triangles = 0;
-	GLfloat (*voronoiCenters)[2] = NULL;
-	bov_points_t *voronoiCentersDraw = bov_points_new(voronoiCenters, n_triangles, GL_STATIC_DRAW);
-	bov_points_set_color(voronoiCentersDraw, VORONOI_POINTS_COLOR);
-	bov_points_set_outline_color(voronoiCentersDraw, VORONOI_POINTS_OUTLINE_COLOR);
-	bov_points_set_width(voronoiCentersDraw, VORONOI_POINTS_WIDTH);
-
-	GLsizei n_voronoi_lines = 0;
-	GLsizei (*voronoiNeighbors)[3] = NULL;
-	GLfloat (*voronoiLines)[2] = NULL;
-	bov_points_t *voronoiLinesDraw = bov_points_new(linesPoints, n_lines, GL_STATIC_DRAW);
-	bov_points_set_color(voronoiLinesDraw, VORONOI_LINES_COLOR);
-	bov_points_set_width(voronoiLinesDraw, VORONOI_LINES_WIDTH);
-	bov_points_set_outline_color(voronoiLinesDraw, VORONOI_LINES_OUTLINE_COLOR);
-	bov_points_set_outline_width(voronoiLinesDraw, .5 * VORONOI_LINES_WIDTH);
-
-	// Write keystrokes in a file
-
-	FILE *file_out = fopen("data/.keys.txt", "w");
-	if (file_out == NULL) {
-		printf("Warning: could not open file data/.keys.txt.\n"
-			   "Make sure to run this program from the project directory to enable keystrokes saving.\n");
-	}
-
-	// Animation parameters
-	DTDrawingParameters *DTDparams;
-
-
-	while(!bov_window_should_close(window)){
-		// 1. Handle key bindings
-		getMousePosition(window, mousePoint[0]);
-		KEY_A = glfwGetKey(window->self, GLFW_KEY_Q); // QWERTY -> AZERTY layout
-		KEY_D = glfwGetKey(window->self, GLFW_KEY_D);
-		KEY_S = glfwGetKey(window->self, GLFW_KEY_S);
-		KEY_F = glfwGetKey(window->self, GLFW_KEY_F);
-		KEY_V = glfwGetKey(window->self, GLFW_KEY_V);
-		KEY_X = glfwGetKey(window->self, GLFW_KEY_X);
-		KEY_O = glfwGetKey(window->self, GLFW_KEY_O);
-		KEY_L = glfwGetKey(window->self, GLFW_KEY_L);
-		KEY_I = glfwGetKey(window->self, GLFW_KEY_I);
-		KEY_G = glfwGetKey(window->self, GLFW_KEY_G);
-		KEY_SHIFT = glfwGetKey(window->self, GLFW_KEY_LEFT_SHIFT) || glfwGetKey(window->self, GLFW_KEY_RIGHT_SHIFT);
-
-		if (KEY_A) {
-			if ((!LAST_KEY_A) || KEY_SHIFT) {
-				REQUIRE_UPDATE = addPoint(delTri, mousePoint[0]);
-				LAST_KEY_A = KEY_A;
-				if (file_out != NULL) {
-					fprintf(file_out, "A\n");
-					fflush(file_out);
-				}
-			}
-		}
-		else {
-			LAST_KEY_A = KEY_A;
-		}
-		if (KEY_D) {
-			if ((!LAST_KEY_D) || KEY_SHIFT) {
-				REQUIRE_UPDATE = deletePoint(delTri, mousePoint[0]);
-				LAST_KEY_D = KEY_D;
-				if (file_out != NULL) {
-					fprintf(file_out, "D\n");
-					fflush(file_out);
-				}
-			}
-		}
-		else {
-			LAST_KEY_D = KEY_D;
-		}
-		if (KEY_S) {
-			idx = getPointIndex(delTri, mousePoint[0]);
-			updatePointAtIndex(delTri, idx, mousePoint[0]);
-			REQUIRE_UPDATE = 1;
-			if (file_out != NULL) {
-				fprintf(file_out, "S\n");
-				fflush(file_out);
-			}
-		}
-		else {
-			idx = -1;
-		}
-		if (KEY_F) {
-			if (!LAST_KEY_F) {
-				FAST = !FAST;
-				LAST_KEY_F = KEY_F;
-				if (file_out != NULL) {
-					fprintf(file_out, "F\n");
-					fflush(file_out);
-				}
-			}
-		}
-		else {
-			LAST_KEY_F = KEY_F;
-		}
-		if (KEY_V) {
-			if (!LAST_KEY_V) {
-				VORONOI = !VORONOI;
-				LAST_KEY_V = KEY_V;
-				REQUIRE_UPDATE = 1;
-				if (file_out != NULL) {
-					fprintf(file_out, "V\n");
-					fflush(file_out);
-				}
-			}
-		}
-		else {
-			LAST_KEY_V = KEY_V;
-		}
-		if (KEY_X) {
-			if (!LAST_KEY_X) {
-				HIDE_TEXT = !HIDE_TEXT;
-				LAST_KEY_X = KEY_X;
-			}
-		}
-		else {
-			LAST_KEY_X = KEY_X;
-		}
-		if (KEY_O) {
-			if (!LAST_KEY_O) {
-				SHOW_POINTS = !SHOW_POINTS;
-				LAST_KEY_O = KEY_O;
-			}
-		}
-		else {
-			LAST_KEY_O = KEY_O;
-		}
-		if (KEY_L) {
-			if (!LAST_KEY_L) {
-				SHOW_LINES = !SHOW_LINES;
-				LAST_KEY_L = KEY_L;
-			}
-		}
-		else {
-			LAST_KEY_L = KEY_L;
-		}
-		if (KEY_I) {
-			if (!LAST_KEY_I) {
-				LAST_KEY_I = KEY_I;
-				ILLUSTRATE = 1;
-			}
-		}
-		else {
-			LAST_KEY_I = KEY_I;
-		}
-		if (KEY_G) {
-			if (!LAST_KEY_G) {
-				SHOW_GAME_RULES = !SHOW_GAME_RULES;
-				LAST_KEY_G = KEY_G;
-			}
-		}
-		else {
-			LAST_KEY_G = KEY_G;
-		}
-
-		if (SHOW_GAME_RULES) {
-			rules_parameters.pos[0] = bov_window_get_xres(window) / 2 - 400;
-			rules_parameters.pos[1] = bov_window_get_yres(window) / 2 + 150;
-			bov_text_set_param(rules, rules_parameters);
-
-			bov_text_draw(window, rules);
-			bov_window_update(window);
-			continue;
-		}
-
-		// 0. We required illustration mode
-
-		else if (ILLUSTRATE) {
-			resetDelaunayTriangulation(delTri);
+ * Connects the destination of an edge of a leaf to the origin of another one,
+ * as connectEdges does.
+ */
+static inline int connectLeafEdges(LeafEdges *leaf, int a, int b) {
+	int e = addLeafEdge(leaf, LEAF_DEST(leaf, a), leaf->orig[b]);
+	spliceLeafEdges(leaf, e, LEAF_LNEXT(leaf, a));
+	spliceLeafEdges(leaf, e ^ 1, b);
+	return e;
+}
 
-			getPointsBoudingBox(delTri->points, delTri->n_points, bounds);
+/*
+ * Flips an edge of a leaf, as flipEdge does.
+ */
+static inline void flipLeafEdge(LeafEdges *leaf, int e) {
+	int a = leaf->oprev[e];
+	int b = leaf->oprev[e ^ 1];
 
-			// Active points
-		    bov_points_t *activePointsDraw = bov_points_new(delTri->points, delTri->n_points, GL_STATIC_DRAW);
-			bov_points_set_color(activePointsDraw, ACTIVE_POINTS_COLOR);
-			bov_points_set_outline_color(activePointsDraw, ACTIVE_POINTS_OUTLINE_COLOR);
-			bov_points_set_width(activePointsDraw, ACTIVE_POINTS_WIDTH);
+	spliceLeafEdges(leaf, e, a);
+	spliceLeafEdges(leaf, e ^ 1, b);
+	spliceLeafEdges(leaf, e, LEAF_LNEXT(leaf, a));
+	spliceLeafEdges(leaf, e ^ 1, LEAF_LNEXT(leaf, b));
 
-			// Trying to make the sleep time % to the inverse of the number of edges
+	leaf->orig[e] = LEAF_DEST(leaf, a);
+	leaf->orig[e ^ 1] = LEAF_DEST(leaf, b);
+}
 
-			int sleep = (int) (total_time / (delTri->n_edges_max));
+/*
+ * Triangulates a slice of sorted points without dividing it, for the leaves of
+ * the divide and conquer (see delTri->leaf_size). The points are inserted
+ * from left to right in edges kept on the stack (see LeafEdges): as each
+ * point is to the right of the previous ones, it is connected to the convex
+ * hull edges it sees, from the last point, and the Delaunay property is
+ * restored with flips, as insertPoint does. The edges are then copied to the
+ * DelaunayTriangulation, so no edge is ever deleted, nor merged.
+ *
+ * delTri: 		the DelaunayTriangulation structure
+ * start:		the start index of the slice
+ * end:			the (excluded) end index of the slice, with 2 to LEAF_SIZE_MAX points
+ * el:			an Edge structure pointer for the left edge (as triangulate)
+ * er:			an Edge structure pointer for the right edge (as triangulate)
+ *
+ * returns:		1 on success, 0 if an edge could not be allocated
+ */
+int triangulateLeaf(DelaunayTriangulation *delTri, DTsize start, DTsize end, EdgeRef *el, EdgeRef *er) {
+	DTfloat (*points)[2] = delTri->points + start;
+	int n = end - start;
+	LeafEdges leaf_edges, *leaf = &leaf_edges;
+	uint16_t stack[LEAF_EDGES];
+	EdgeRef edges[LEAF_EDGES];
 
-			DTDparams = initDTDrawingParameters(
-				delTri,
-				window,
-				linesPoints,
-				pointsDraw,
-				activePointsDraw,
-				linesDraw,
-				bounds,
-				FAST,
-				sleep
-			);
+#define SEES(p, e) (coordsCompareSegment(delTri, points[p], points[leaf->orig[e]], points[LEAF_DEST(leaf, e)]) == -1)
 
-			triangulateDTIllustrated(DTDparams);
+	leaf->n_edges = 0;
 
-			freeDTDrawingParameters(DTDparams);
+	// Convex hull edge out of the last point, with the outer face on its left
+	int h = addLeafEdge(leaf, 0, 1) ^ 1;
 
-			bov_points_delete(activePointsDraw);
+	for (int p = 2; p < n; p++) {
+		int e = LEAF_LPREV(leaf, h), n_stack = 0;
 
-			ILLUSTRATE = 0;
+		if (SEES(p, e)) {
+			while (SEES(p, LEAF_LPREV(leaf, e))) {
+				e = LEAF_LPREV(leaf, e);
+			}
+		}
+		else if (SEES(p, h)) {
+			e = h;
+		}
+		else {
+			// Colinear with all the previous points, which only form a line
+			int f = addLeafEdge(leaf, p - 1, p);
+			spliceLeafEdges(leaf, f, h);
+			h = f ^ 1;
+			continue;
 		}
 
-		// 1.A If key bindings required an update in the drawing
-		if (REQUIRE_UPDATE) {
-			// Recompute triangulation
-			triangulateDT(delTri);
-			getInfoText(delTri, info_text_char);
-
-			getPointsBoudingBox(delTri->points, delTri->n_points, bounds);
-
-			//printf("bounds = (%f, %f) (%f, %f)\n", bounds[0][0], bounds[0][1], bounds[1][0], bounds[1][1]);
-
-			if (delTri->success) {
-
-				// Free old lines
-				if (linesPoints != NULL) free(linesPoints);
-
-				// Get new lines
-				n_lines = getDelaunayTriangulationNumberOfLines(delTri);
-				linesPoints = malloc(sizeof(linesPoints[0]) * 2 * n_lines);
-				getDelaunayTriangulationLines(delTri, linesPoints, n_lines);
-
-				// Update lines
-				bov_points_update(linesDraw, linesPoints, 2 * n_lines);
-
-				if (VORONOI) {
-					// Free old data
-					if (voronoiCenters != NULL) free(voronoiCenters);
-					if (voronoiNeighbors != NULL) free(voronoiNeighbors);
-					if (voronoiLines != NULL) free(voronoiLines);
-
-
-					// Get new Voronoi centers and lines
-					n_triangles = getNumberOfTriangles(delTri);
-
-					voronoiCenters = malloc(sizeof(voronoiCenters[0]) * n_triangles);
-					voronoiNeighbors = malloc(sizeof(voronoiNeighbors[0]) * n_triangles);
-
-					getVoronoiCentersAndNeighbors(delTri,
-												  voronoiCenters,
-											      voronoiNeighbors,
-											      n_triangles);
-
-					// Update Voronoi centers
-					bov_points_update(voronoiCentersDraw, voronoiCenters, n_triangles);
+		int base = addLeafEdge(leaf, leaf->orig[e], p);
+		spliceLeafEdges(leaf, base, e);
+
+		do {
+			int s = LEAF_LNEXT(leaf, e);
+			stack[n_stack++] = e;
+			base = connectLeafEdges(leaf, e, base ^ 1);
+			e = s;
+		} while (SEES(p, e));
+		h = base ^ 1;
+
+		while (n_stack > 0) {
+			e = stack[--n_stack];
+			int t = leaf->oprev[e];
+
+			if ((coordsCompareSegment(delTri, points[LEAF_DEST(leaf, t)], points[leaf->orig[e]], points[LEAF_DEST(leaf, e)]) == 1) &&
+				(pointInCircle(delTri, start + p, start + leaf->orig[e], start + LEAF_DEST(leaf, t), start + LEAF_DEST(leaf, e)))) {
+				int u = LEAF_LNEXT(leaf, t);
+				flipLeafEdge(leaf, e);
+				stack[n_stack++] = t;
+				stack[n_stack++] = u;
+			}
+		}
+	}
+#undef SEES
 
-					voronoiLines = malloc(sizeof(voronoiLines[0]) * 3 * 2 * n_triangles);
+	for (int e = 0; e < leaf->n_edges; e += 2) {
+		edges[e] = addEdge(delTri, start + leaf->orig[e], start + leaf->orig[e ^ 1]);
+		if (edges[e] == EDGE_NULL) return 0;
+		edges[e ^ 1] = SYM(delTri, edges[e]);
+	}
+	for (int e = 0; e < leaf->n_edges; e++) {
+		ONEXT(delTri, edges[e]) = edges[leaf->onext[e]];
+		OPREV(delTri, edges[e]) = edges[leaf->oprev[e]];
+	}
 
-					getVoronoiLines(delTri,
-									voronoiCenters,
-									voronoiNeighbors,
-									voronoiLines,
-									n_triangles);
+	// The first point is on the convex hull, found by walking along the outer face
+	int f = h;
+	while (leaf->orig[f] != 0) {
+		f = LEAF_LNEXT(leaf, f);
+	}
 
-					bov_points_update(voronoiLinesDraw, voronoiLines, 3 * 2 * n_triangles);
+	// As triangulate, the right edge has the outer face on its right
+	*el = edges[f];
+	*er = edges[leaf->onext[h]];
+	return 1;
+}
 
+/*
+ * Returns the convex hull edge out of the first (or last) point of a
+ * triangulation along an axis (see pointIsBefore), walking along the hull from
+ * a given edge. As the hull is convex, the points get closer to the extreme
+ * one in a single direction.
+ *
+ * delTri: 		the DelaunayTriangulation structure
+ * e:			an edge of the hull, with the triangulation on its left (as ldo)
+ * axis:		0 for x, 1 for y
+ * last:		if set, the last point is searched instead of the first one
+ *
+ * returns:		the edge out of the extreme point, with the triangulation on its left
+ */
+EdgeRef getExtremeHullEdge(DelaunayTriangulation *delTri, EdgeRef e, int axis, int last) {
+	DTfloat (*points)[2] = delTri->points;
+#define FURTHER(i, j) (last ? pointIsBefore(points[j], points[i], axis) : pointIsBefore(points[i], points[j], axis))
+
+	if (FURTHER(DEST(delTri, e), ORIG(delTri, e))) {
+		// Counterclockwise along the hull
+		do {
+			e = OPREV(delTri, SYM(delTri, e));
+		} while (FURTHER(DEST(delTri, e), ORIG(delTri, e)));
+		return e;
+	}
 
-				}
-			}
+	// Clockwise along the hull, with the triangulation on the right of f (as ldi)
+	EdgeRef f = ONEXT(delTri, e);
+	while (FURTHER(DEST(delTri, f), ORIG(delTri, f))) {
+		f = ONEXT(delTri, SYM(delTri, f));
+	}
+	return OPREV(delTri, f);
+#undef FURTHER
+}
 
-			// Update new points
-			bov_points_update(pointsDraw, delTri->points, delTri->n_points);
+/*
+ * Triangulates all the points with the divide and conquer of triangulate (or,
+ * if delTri->cuts is ALTERNATING_CUTS, with the cuts of arrangePoints), but
+ * without recursion. The slices of the recursion are first listed in a work
+ * list, node i being halved into nodes 2i + 1 and 2i + 2, in the order in
+ * which the recursion would triangulate and merge them. The tree is cut at
+ * the depth where there are about 4 subtrees per thread: each subtree is
+ * processed in that order by one thread, which keeps its points in cache,
+ * and the nodes above are merged level by level, the merges of a level being
+ * shared between threads. With one thread, the whole tree is one subtree.
+ *
+ * delTri: 		the DelaunayTriangulation structure, with at least 2 points
+ * n_threads: 	the number of threads, the edges must be taken from arenas if more than one
+ * el:			an Edge structure pointer for the left edge
+ * er:			an Edge structure pointer for the right edge
+ *
+ * returns:		1 on success, 0 if there was not enough memory
+ */
+int triangulateBottomUp(DelaunayTriangulation *delTri, int n_threads, EdgeRef *el, EdgeRef *er) {
+	DTsize n = delTri->n_points;
+	DTsize leaf = getLeafSize(delTri);
+	int depth = (int) getRecursionDepth(n, leaf);
+	size_t n_nodes = ((size_t) 2 << depth) - 1;
+	int alternating = (delTri->cuts == ALTERNATING_CUTS);
+
+	// Nodes above this depth are merged level by level, the others by the thread of their subtree
+	int split = 0;
+	while ((n_threads > 1) && (split < depth) && (((DTsize) 1 << split) < 4 * (DTsize) n_threads)) split++;
+	DTsize first_split = ((DTsize) 1 << split) - 1;
+
+	DTsize (*slices)[2] = calloc(n_nodes, sizeof(slices[0]));	// start and (excluded) end of each node, 0 if no such node
+	EdgeRef (*hulls)[2] = malloc(sizeof(hulls[0]) * n_nodes);	// left and right edges of the triangulation of each node
+	unsigned char *axes = malloc(n_nodes);						// axis along which each node is halved
+	DTsize *steps = malloc(sizeof(DTsize) * n_nodes);			// nodes, each one after its halves (as the recursion returns)
+	DTsize (*tasks)[2] = malloc(sizeof(tasks[0]) * (2 * first_split + 1));	// first and (excluded) last steps of each subtree
+
+	if ((slices == NULL) || (hulls == NULL) || (axes == NULL) || (steps == NULL) || (tasks == NULL)) {
+		printf("ERROR: Couldn't allocate memory for the work list of the triangulation\n");
+		free(slices); free(hulls); free(axes); free(steps); free(tasks);
+		return 0;
+	}
 
-			// Draws a red point where the mouse was when key was pressed
-			bov_points_update(mouseDraw, mousePoint, 1);
-			bov_points_set_color(mouseDraw, (GLfloat[4]) {1.0, 0.0, 0.0, 1.0});
-			bov_points_set_width(mouseDraw, MOUSE_POINTS_WIDTH);
+	// Depth-first listing of the nodes, second half first, so that the reversed
+	// list has the halves of each node before it. The stack never holds more
+	// than depth + 2 nodes.
+	DTsize stack[64];
+	int n_stack = 0;
+	DTsize n_steps = 0;
+
+	slices[0][0] = 0;
+	slices[0][1] = n;
+	axes[0] = 0;
+	stack[n_stack++] = 0;
+
+	while (n_stack > 0) {
+		DTsize i = stack[--n_stack];
+		DTsize start = slices[i][0], size = slices[i][1] - slices[i][0];
+		steps[n_steps++] = i;
+		if (size <= leaf) continue;
+
+		DTsize m = (size + 1) / 2;
+		int axis = alternating ? getCutAxis(delTri->points + start, size, axes[i]) : 0;
+		axes[i] = axis;
+		slices[2 * i + 1][0] = start;
+		slices[2 * i + 1][1] = start + m;
+		slices[2 * i + 2][0] = start + m;
+		slices[2 * i + 2][1] = start + size;
+		axes[2 * i + 1] = axes[2 * i + 2] = alternating ? 1 - axis : 0;
+
+		stack[n_stack++] = 2 * i + 1;
+		stack[n_stack++] = 2 * i + 2;
+	}
 
-			GLsizei n_triangles = getNumberOfTriangles(delTri);
+	for (DTsize k = 0; k < n_steps / 2; k++) {
+		DTsize tmp = steps[k];
+		steps[k] = steps[n_steps - 1 - k];
+		steps[n_steps - 1 - k] = tmp;
+	}
 
-			REQUIRE_UPDATE = 0;
+	// A subtree is rooted at a node of the split depth, or at a leaf above it,
+	// and its steps follow the previous subtree or node above the split depth
+	DTsize n_tasks = 0, begin = 0;
+	for (DTsize k = 0; k < n_steps; k++) {
+		DTsize i = steps[k];
+		if ((i < first_split) && (slices[i][1] - slices[i][0] > leaf)) {
+			begin = k + 1;
 		}
-		// 1.B If no update required, a smooth fading is applied to the red point
-		else {
-			bov_points_param_t param = bov_points_get_param(mouseDraw);
-			param.fillColor[3] *= 0.95;
-			param.width -= (param.width - BASIC_POINTS_WIDTH) / 10;
-			bov_points_set_param(mouseDraw, param);
-		}
-
-		// 2. Drawing
-		if (delTri->success) {
-			if (FAST) {
-				if (SHOW_LINES) bov_fast_lines_draw(window, linesDraw, 0, BOV_TILL_END);
-				if (VORONOI) {
-					bov_fast_lines_draw(window, voronoiLinesDraw, 0, BOV_TILL_END);
-					bov_fast_points_draw(window, voronoiCentersDraw, 0, BOV_TILL_END);
+		else if ((i < first_split) || (i == 0) || ((i - 1) / 2 < first_split)) {
+			tasks[n_tasks][0] = begin;
+			tasks[n_tasks][1] = k + 1;
+			n_tasks++;
+			begin = k + 1;
+		}
+	}
+
+	int ok = 1;
+
+	#pragma omp parallel num_threads(n_threads) if (n_threads > 1)
+	{
+		#pragma omp for schedule(dynamic, 1)
+		for (DTsize t = 0; t < n_tasks; t++) {
+			int done = 1;
+			for (DTsize k = tasks[t][0]; (k < tasks[t][1]) && done; k++) {
+				DTsize i = steps[k];
+				if (slices[i][1] - slices[i][0] <= leaf) {
+					done = triangulate(delTri, slices[i][0], slices[i][1], &hulls[i][0], &hulls[i][1]);
 				}
-			}
-			else {
-				if (SHOW_LINES) bov_lines_draw(window, linesDraw, 0, BOV_TILL_END);
-				if (VORONOI) {
-					bov_lines_draw(window, voronoiLinesDraw, 0, BOV_TILL_END);
-					bov_points_draw(window, voronoiCentersDraw, 0, BOV_TILL_END);
+				else {
+					EdgeRef *left = hulls[2 * i + 1], *right = hulls[2 * i + 2];
+					done = alternating ? mergeAlternating(delTri, axes[i], left[0], left[1], right[0], right[1],
+														  &hulls[i][0], &hulls[i][1])
+									   : mergeTriangulations(delTri, left[0], left[1], right[0], right[1],
+															 &hulls[i][0], &hulls[i][1]);
 				}
 			}
+			if (!done) {
+				#pragma omp atomic write
+				ok = 0;
+			}
 		}
-		if (FAST) {
-			if (SHOW_POINTS) bov_fast_points_draw(window, pointsDraw, 0, BOV_TILL_END);
-			bov_fast_points_draw(window, mouseDraw, 0, 1);
-		}
-		else {
-			if (SHOW_POINTS) bov_points_draw(window, pointsDraw, 0, BOV_TILL_END);
-			bov_points_draw(window, mouseDraw, 0, 1);
-		}
-
-		// 3. Adjust text place and boldness
-
-		double wtime = bov_window_get_time(window);
-
-		text_parameters.pos[1] = bov_window_get_yres(window) - 30 ;
-		text_parameters.fillColor[0] = 0.35 * sin(2 * wtime) + 0.35;
-		bov_text_set_param(text, text_parameters);
-
-		bov_text_set_boldness(text, 0.3 * sin(2 * wtime) + 0.3);
-
-		if (!HIDE_TEXT) {
-
-			bov_text_update(info_text, info_text_char);
 
-			bov_text_draw(window, text);
-			bov_text_draw(window, info_text);
+		// ok is the same for all threads after the implicit barrier of each level
+		for (int d = split - 1; (d >= 0) && ok; d--) {
+			DTsize first = ((DTsize) 1 << d) - 1;
+
+			#pragma omp for schedule(static)
+			for (DTsize i = first; i < 2 * first + 1; i++) {
+				if (slices[i][1] - slices[i][0] <= leaf) continue; // leaf, or no such node
+
+				EdgeRef *left = hulls[2 * i + 1], *right = hulls[2 * i + 2];
+				int merged = alternating ? mergeAlternating(delTri, axes[i], left[0], left[1], right[0], right[1],
+															&hulls[i][0], &hulls[i][1])
+										 : mergeTriangulations(delTri, left[0], left[1], right[0], right[1],
+															   &hulls[i][0], &hulls[i][1]);
+				if (!merged) {
+					#pragma omp atomic write
+					ok = 0;
+				}
+			}
 		}
-
-		// 4. Update windows
-		bov_window_update(window);
 	}
 
-	// Free all memory allocated
-	bov_text_delete(text);
-	bov_text_delete(info_text);
-	bov_text_delete(rules);
-	bov_points_delete(pointsDraw);
-	bov_points_delete(linesDraw);
-	bov_points_delete(mouseDraw);
-	bov_points_delete(voronoiCentersDraw);
-	bov_points_delete(voronoiLinesDraw);
-
-	if (linesPoints != NULL) free(linesPoints);
-	if (voronoiCenters != NULL) free(voronoiCenters);
-	if (voronoiNeighbors != NULL) free(voronoiNeighbors);
-	if (voronoiLines != NULL) free(voronoiLines);
+	*el = hulls[0][0];
+	*er = hulls[0][1];
 
-	if (file_out != NULL) fclose(file_out);
+	free(slices);
+	free(hulls);
+	free(axes);
+	free(steps);
+	free(tasks);
+	return ok;
 }
 
 /*
- * Re-Draws the DelaunayTriangulation points and lines.
+ * Merges two adjacent triangulations as mergeTriangulations does, their
+ * points being separated along an axis (see pointIsBefore). Their edges are
+ * the ones of a merge along the other axis (or of triangulate), from which the
+ * extreme points along this axis are found.
  *
- * delTri:		the DelaunayTriangulation structure
- * window:		the window
- * linesPoints:	the preallocated array that will all the lines points, be sure that it contains enough space for all the lines!
- * pointsDraw:	the structure used to draw the points
- * activePointsDraw:	the structure used to draw the active points
- * linesDraw:	the structure used to draw the lines
- * FAST:		if 1, will use fast drawing
- * sleep:		the sleep time in microseconds after calling the function
- * bounds:		the bounding box of the points
+ * delTri: 		the DelaunayTriangulation structure
+ * axis:		the axis along which the points are separated, 0 for x and 1 for y
+ * ldo, ldi:	the first and last edges of the first triangulation
+ * rdi, rdo:	the first and last edges of the second triangulation
+ * el:			an Edge structure pointer for the first edge of the merge along the axis
+ * er:			an Edge structure pointer for the last edge of the merge along the axis
  *
- * returns:		a new DTDrawingParameters structure
+ * returns:		1 on success, 0 if an edge could not be allocated
  */
-DTDrawingParameters* initDTDrawingParameters(DelaunayTriangulation *delTri,
-											 bov_window_t *window,
-						 					 GLfloat linesPoints[][2],
-						 					 bov_points_t *pointsDraw,
-											 bov_points_t *activePointsDraw,
-											 bov_points_t *linesDraw,
-											 GLfloat bounds[][2],
-						 					 int FAST, int sleep) {
+int mergeAlternating(DelaunayTriangulation *delTri, int axis, EdgeRef ldo, EdgeRef ldi, EdgeRef rdi, EdgeRef rdo,
+					 EdgeRef *el, EdgeRef *er) {
+	ldo = getExtremeHullEdge(delTri, ldo, axis, 0);
+	ldi = ONEXT(delTri, getExtremeHullEdge(delTri, OPREV(delTri, ldi), axis, 1));
+	rdi = getExtremeHullEdge(delTri, rdi, axis, 0);
+	rdo = ONEXT(delTri, getExtremeHullEdge(delTri, OPREV(delTri, rdo), axis, 1));
+
+	return mergeTriangulations(delTri, ldo, ldi, rdi, rdo, el, er);
+}
 
-	DTDrawingParameters *DTDparams = malloc(sizeof(DTDrawingParameters));
-	DTDparams->delTri = delTri;
-	DTDparams->window = window;
-	DTDparams->linesPoints = linesPoints;
-	DTDparams->pointsDraw = pointsDraw;
-	DTDparams->activePointsDraw = activePointsDraw;
-	DTDparams->linesDraw = linesDraw;
-	DTDparams->FAST = FAST;
-	DTDparams->sleep = sleep;
-	DTDparams->draw_circle = 1;
+/*
+ * Returns the depth of the divide and conquer of triangulate (or
+ * triangulateBottomUp) on a number of points, i.e. the number of times the
+ * largest slice is halved before reaching the size of a leaf. It only depends
+ * on the number of points and on the size of the leaves.
+ *
+ * n_points:	the number of points
+ * leaf_size:	the largest number of points of a leaf, at least 3 (see delTri->leaf_size)
+ *
+ * returns:		the depth of the deepest call, 0 if no recursion is needed
+ */
+unsigned long getRecursionDepth(DTsize n_points, DTsize leaf_size) {
+	unsigned long depth = 0;
+	while (n_points > leaf_size) {
+		n_points = (n_points + 1) / 2;
+		depth++;
+	}
+	return depth;
+}
 
-	GLfloat dy = bounds[1][1] - bounds[0][1];
+/*
+ * Merges two adjacent triangulations, the left one being made of points whose
+ * indices are all smaller than the ones of the right triangulation.
+ *
+ * delTri: 		the DelaunayTriangulation structure
+ * ldo:			the left edge of the left triangulation
+ * ldi:			the right edge of the left triangulation
+ * rdi:			the left edge of the right triangulation
+ * rdo:			the right edge of the right triangulation
+ * el:			an Edge structure pointer for the left edge of the merge
+ * er:			an Edge structure pointer for the right edge of the merge
+ *
+ * returns:		1 on success, 0 if an edge could not be allocated
+ */
+int mergeTriangulations(DelaunayTriangulation *delTri, EdgeRef ldo, EdgeRef ldi, EdgeRef rdi, EdgeRef rdo,
+						EdgeRef *el, EdgeRef *er) {
+	// Computes the upper common tangent of left and right edges
+	while (1) {
+		DT_COUNT(delTri, tangent_steps);
+		if 		(pointCompareEdge(delTri, ORIG(delTri, rdi), ldi) ==  1) {
+			ldi = ONEXT(delTri, SYM(delTri, ldi));
+		}
+		else if (pointCompareEdge(delTri, ORIG(delTri, ldi), rdi) == -1) {
+			rdi = OPREV(delTri, SYM(delTri, rdi));
+		}
+		else {
+			break;
+		}
+	}
 
-	DTDparams->y_min = bounds[0][1] - 0.25 * dy;
-	DTDparams->y_max = bounds[1][1] + 0.25 * dy;
+	EdgeRef base;
 
-	DTDparams->n_divides = 0;
-	DTDparams->n_divides_max = delTri->n_points >> 1;
+	// Creates an edge between rdi.orig and ldi.orig
+	base = connectEdges(delTri, SYM(delTri, ldi), rdi);
+	if (base == EDGE_NULL) return 0;
 
-	DTDparams->divideLinesPoints = malloc(sizeof(DTDparams->divideLinesPoints[0]) * DTDparams->n_divides_max * 2);
-	DTDparams->divideLinesDraw = bov_points_new(DTDparams->divideLinesPoints, DTDparams->n_divides_max * 2, GL_STATIC_DRAW);
-	DTDparams->divideLinesMask = calloc(DTDparams->n_divides_max, sizeof(char));
+	// Ajdusts ldo and rdo
+	if (ORIG(delTri, ldi) == ORIG(delTri, ldo)) {
+		ldo = base;
+	}
+	if (ORIG(delTri, rdi) == ORIG(delTri, rdo)) {
+		rdo = SYM(delTri, base);
+	}
 
-	bov_points_set_color(DTDparams->divideLinesDraw, DIVIDE_LINES_COLOR);
-	bov_points_set_width(DTDparams->divideLinesDraw, DIVIDE_LINES_WIDTH);
+	EdgeRef lcand, rcand, tmp;
+	int v_rcand, v_lcand;
 
-	GLfloat dtheta = 2 * M_PI / (GLfloat) N_POINTS;
-	GLfloat theta = 0.0;
+	// We merge both parts
+	while (1) {
+		DT_COUNT(delTri, merge_steps);
+		// Locates the first right and left points to be encountered
+		// by the diving bubble
 
-	for (GLsizei i = 0; i < N_POINTS; i++) {
-		DTDparams->cos_[i] = cos(theta);
-		DTDparams->sin_[i] = sin(theta);
+		rcand = ONEXT(delTri, SYM(delTri, base));
+		lcand = OPREV(delTri, base);
 
-		theta += dtheta;
-	}
+		v_rcand = (pointCompareEdge(delTri, DEST(delTri, rcand), base) == 1);
+		v_lcand = (pointCompareEdge(delTri, DEST(delTri, lcand), base) == 1);
+		if (!(v_rcand || v_lcand)) {
+			// Merge is done
+			break;
+		}
+		// Deletes right edges that fail the circle test
+		if (v_rcand) {
+			while ((pointCompareEdge(delTri, DEST(delTri, ONEXT(delTri, rcand)), base) == 1) &&
+				   (pointInCircle(delTri, DEST(delTri, ONEXT(delTri, rcand)), DEST(delTri, base), ORIG(delTri, base), DEST(delTri, rcand)))
+			   )
+				   {
+					   tmp = ONEXT(delTri, rcand);
+					   deleteEdge(delTri, rcand);
+					   rcand = tmp;
+				   }
+		}
+		// Deletes left edges that fail the circle test
+		if (v_lcand) {
+			while ((pointCompareEdge(delTri, DEST(delTri, OPREV(delTri, lcand)), base) == 1) &&
+				   (pointInCircle(delTri, DEST(delTri, OPREV(delTri, lcand)), DEST(delTri, base), ORIG(delTri, base), DEST(delTri, lcand)))
+			   )
+				   {
+					   tmp = OPREV(delTri, lcand);
+					   deleteEdge(delTri, lcand);
+					   lcand = tmp;
+				   }
+		}
 
-	DTDparams->searchPointsDraw = bov_points_new(DTDparams->delTri->points, DTDparams->delTri->n_points, GL_STATIC_DRAW);
-	DTDparams->circlePointsDraw = bov_points_new(DTDparams->circ, N_POINTS, GL_STATIC_DRAW);
-	DTDparams->searchPointsOrder = bov_order_new(DTDparams->searchPoints, 3, GL_STATIC_DRAW);
+		if ((!v_rcand) ||
+			(v_rcand && pointInCircle(delTri, DEST(delTri, lcand), DEST(delTri, rcand), ORIG(delTri, rcand), ORIG(delTri, lcand)))
+		) {
 
-	bov_points_set_color(DTDparams->searchPointsDraw, SEARCHED_POINTS_COLOR);
-	bov_points_set_width(DTDparams->searchPointsDraw, SEARCHED_POINTS_WIDTH);
-	bov_points_set_color(DTDparams->circlePointsDraw, CIRCLE_LINES_COLOR);
-	bov_points_set_width(DTDparams->circlePointsDraw, CIRCLE_LINES_WIDTH);
+			tmp = connectEdges(delTri, lcand, SYM(delTri, base));
+			if (tmp == EDGE_NULL) return 0;
+			base = tmp;
+		}
+		else {
+			tmp = connectEdges(delTri, SYM(delTri, base), SYM(delTri, rcand));
+			if (tmp == EDGE_NULL) return 0;
+			base = tmp;
+		}
+	}
 
-	return DTDparams;
+	*el = ldo;
+	*er = rdo;
+	return 1;
 }
 
 /*
- * Sets the new triplet of points to be the triangle from which the
- * cicurmcicle will be computed.
+ * Returns 1 if the face on the left of an edge is the outer face of the
+ * triangulation (i.e. not a triangle), 0 otherwise.
  *
- * DTDparams:	the DTDrawingParameters structure
- * i_a,b,c:		the point indices
+ * delTri: 		the DelaunayTriangulation structure
+ * e: 			the edge
+ *
+ * returns:		1 if outer face, 0 if triangle
  */
-void setSearchPoints(DTDrawingParameters *DTDparams,
-					 GLsizei i_a, GLsizei i_b ,GLsizei i_c) {
-
-	DTDparams->searchPoints[0] = i_a;
-	DTDparams->searchPoints[1] = i_b;
-	DTDparams->searchPoints[2] = i_c;
-
-	bov_order_update(DTDparams->searchPointsOrder, DTDparams->searchPoints, 3);
-
-	GLfloat radius, center[2];
-	radius = circleCenter(DTDparams->delTri, i_a, i_b, i_c, center);
-
-	for (GLsizei i = 0; i < N_POINTS; i++) {
-		DTDparams->circ[i][0] = center[0] + radius * DTDparams->cos_[i];
-		DTDparams->circ[i][1] = center[1] + radius * DTDparams->sin_[i];
+int isOuterFace(DelaunayTriangulation *delTri, EdgeRef e) {
+	EdgeRef f = LNEXT(delTri, e);
+	if (LNEXT(delTri, LNEXT(delTri, f)) != e) {
+		return 1;
 	}
-
-	bov_points_update(DTDparams->circlePointsDraw, DTDparams->circ, N_POINTS);
-
+	return pointCompareEdge(delTri, DEST(delTri, f), e) != -1;
 }
 
 /*
- * Adds a dividing line at pivot point.
+ * Returns an edge that can be used to start walking in the triangulation.
+ * The hint of the DelaunayTriangulation is used if still valid.
+ *
+ * delTri: 		the DelaunayTriangulation structure
  *
- * DTDparams:	the DTDrawingParameters structure
- * pivot:		the pivot point (start of right half)
+ * returns:		an edge, EDGE_NULL if there is none
  */
-GLsizei addDivideLine(DTDrawingParameters *DTDparams, GLsizei pivot) {
-	if (DTDparams->n_divides == DTDparams->n_divides_max) {
-		printf("ERROR: Not enough space was allocated for divide lines\n");
-		exit(EXIT_FAILURE);
+EdgeRef getHintEdge(DelaunayTriangulation *delTri) {
+	if ((delTri->hint != EDGE_NULL) && (!IS_DISCARDED(delTri, delTri->hint))) {
+		return delTri->hint;
+	}
+	for (DTsize i = 0; i < delTri->n_edges; i += 2) {
+		if (!IS_DISCARDED(delTri, EDGE_REF(delTri, i))) {
+			delTri->hint = EDGE_REF(delTri, i);
+			return delTri->hint;
+		}
 	}
+	return EDGE_NULL;
+}
 
-	GLsizei divide_index = DTDparams->n_divides;
+/*
+ * Walks from an edge to the face containing a point. Because the
+ * triangulation is Delaunay, the walk always terminates.
+ *
+ * delTri: 		the DelaunayTriangulation structure
+ * point: 		the point (x, y) to locate
+ * e: 			the edge from which to start
+ * outside: 	set to 1 if the point is outside the convex hull, 0 otherwise
+ *
+ * returns:		if inside, an edge of the triangle (on its left) containing the point, which
+ * 				may lie on its edges. If outside, an edge of the convex hull, with the outer face on
+ * 				its left, that sees the point strictly on its left. EDGE_NULL if all the points of the
+ * 				triangulation and the point are colinear.
+ */
+EdgeRef locatePointFromEdge(DelaunayTriangulation *delTri, DTfloat point[2], EdgeRef e, int *outside) {
+	// Inspired from: Guibas & Stolfi (1985), Locate procedure
+	EdgeRef f;
+	int cmp = coordsCompareEdge(delTri, point, e);
 
-	DTDparams->divideLinesMask[divide_index] = 1;
+	if ((cmp == 1) || ((cmp == 0) && isOuterFace(delTri, e))) {
+		e = SYM(delTri, e);
+	}
 
-	GLfloat x_mean = 0.5 * (DTDparams->delTri->points[pivot - 1][0] + DTDparams->delTri->points[pivot][0]);
+	while (1) {
+		if (isOuterFace(delTri, e)) {
+			if (coordsCompareEdge(delTri, point, e) != -1) {
+				return EDGE_NULL;
+			}
+			*outside = 1;
+			return e;
+		}
+		f = LNEXT(delTri, e);
+		if (coordsCompareEdge(delTri, point, f) == 1) {
+			e = SYM(delTri, f);
+			continue;
+		}
+		f = LNEXT(delTri, f);
+		if (coordsCompareEdge(delTri, point, f) == 1) {
+			e = SYM(delTri, f);
+			continue;
+		}
+		*outside = 0;
+		return e;
+	}
+}
 
-	DTDparams->divideLinesPoints[2 * divide_index    ][0] = x_mean;
-	DTDparams->divideLinesPoints[2 * divide_index    ][1] = DTDparams->y_min;
-	DTDparams->divideLinesPoints[2 * divide_index + 1][0] = x_mean;
-	DTDparams->divideLinesPoints[2 * divide_index + 1][1] = DTDparams->y_max;
+/*
+ * Returns an edge starting from a point of the triangulation, found by walking
+ * from the hint edge.
+ *
+ * delTri: 		the DelaunayTriangulation structure
+ * i_p: 		the index of the point
+ *
+ * returns:		an edge whose origin is the point, EDGE_NULL if not found (colinear points)
+ */
+EdgeRef getPointEdge(DelaunayTriangulation *delTri, DTsize i_p) {
+	EdgeRef e = getHintEdge(delTri);
+	int outside;
 
-	DTDparams->n_divides++;
+	if (e == EDGE_NULL) return EDGE_NULL;
 
-	bov_points_update(DTDparams->divideLinesDraw, DTDparams->divideLinesPoints, 2 * DTDparams->n_divides);
+	e = locatePointFromEdge(delTri, delTri->points[i_p], e, &outside);
+	if ((e == EDGE_NULL) || (outside)) return EDGE_NULL;
 
-	return divide_index;
+	if (ORIG(delTri, e) == i_p) return e;
+	e = LNEXT(delTri, e);
+	if (ORIG(delTri, e) == i_p) return e;
+	e = LNEXT(delTri, e);
+	if (ORIG(delTri, e) == i_p) return e;
+	return EDGE_NULL;
 }
 
-void deleteDivideLine(DTDrawingParameters *DTDparams, GLsizei index) {
-	DTDparams->divideLinesMask[index] = 0;
+/*
+ * Restores the Delaunay property around a point that was just inserted, by
+ * flipping the edges of the stack that fail the circle test (Lawson's
+ * algorithm). The point must be on the left of each edge in the stack, and
+ * every flipped edge adds its two neighbours to the stack.
+ *
+ * delTri: 		the DelaunayTriangulation structure
+ * i_p: 		the index of the point
+ * n_stack: 	the number of edges in the stack
+ *
+ * returns:		1 on success, 0 if the stack could not grow
+ */
+int legalizeEdges(DelaunayTriangulation *delTri, DTsize i_p, DTsize n_stack) {
+	EdgeRef e, t, u;
+
+	while (n_stack > 0) {
+		e = delTri->edge_stack[--n_stack];
+		t = OPREV(delTri, e);
+
+		// A convex hull edge never has a point on its right
+		if ((pointCompareEdge(delTri, DEST(delTri, t), e) == 1) &&
+			(pointInCircle(delTri, i_p, ORIG(delTri, e), DEST(delTri, t), DEST(delTri, e)))) {
+			u = LNEXT(delTri, t);
+			flipEdge(delTri, e);
+			if ((!pushEdge(delTri, &n_stack, t)) || (!pushEdge(delTri, &n_stack, u))) {
+				return 0;
+			}
+		}
+	}
+	return 1;
 }
 
 /*
- * Frees a DTDrawingParameters structure and everything it has allocated.
+ * Restores the Delaunay property by flipping the edges of the stack that are
+ * not locally Delaunay (Lawson's algorithm). Unlike legalizeEdges, no point
+ * is assumed to be common to the edges: every flipped edge adds the four
+ * edges of its quadrilateral to the stack.
+ *
+ * delTri: 		the DelaunayTriangulation structure
+ * n_stack: 	the number of edges in the stack
  *
- * DTDparams:	the DTDrawingParameters structure
+ * returns:		1 on success, 0 if the stack could not grow
  */
-void freeDTDrawingParameters(DTDrawingParameters *DTDparams) {
-	if (DTDparams != NULL) {
-		if (DTDparams->divideLinesPoints != NULL) free(DTDparams->divideLinesPoints);
-		if (DTDparams->divideLinesDraw != NULL) bov_points_delete(DTDparams->divideLinesDraw);
-		if (DTDparams->divideLinesMask != NULL) free(DTDparams->divideLinesMask);
-		if (DTDparams->searchPointsDraw != NULL) bov_points_delete(DTDparams->searchPointsDraw);
-		if (DTDparams->circlePointsDraw != NULL) bov_points_delete(DTDparams->circlePointsDraw);
-		if (DTDparams->searchPointsOrder != NULL) bov_order_delete(DTDparams->searchPointsOrder);
-		free(DTDparams);
+int flipEdges(DelaunayTriangulation *delTri, DTsize n_stack) {
+	EdgeRef e, t;
+
+	while (n_stack > 0) {
+		e = delTri->edge_stack[--n_stack];
+		if (isOuterFace(delTri, e) || isOuterFace(delTri, SYM(delTri, e))) continue;
+
+		t = OPREV(delTri, e);
+		if (pointInCircle(delTri, DEST(delTri, LNEXT(delTri, e)), ORIG(delTri, e), DEST(delTri, t), DEST(delTri, e))) {
+			if ((!pushEdge(delTri, &n_stack, LNEXT(delTri, e))) ||
+				(!pushEdge(delTri, &n_stack, LPREV(delTri, e))) ||
+				(!pushEdge(delTri, &n_stack, LNEXT(delTri, SYM(delTri, e)))) ||
+				(!pushEdge(delTri, &n_stack, LPREV(delTri, SYM(delTri, e))))) {
+				return 0;
+			}
+			flipEdge(delTri, e);
+		}
 	}
+	return 1;
 }
 
 /*
- * Re-Draws the DelaunayTriangulation points and lines.
+ * Inserts a point into an already computed triangulation: the face containing
+ * the point is found by walking from the hint edge, the point is connected to
+ * the points of this face (or to the points of the convex hull it sees) and the
+ * Delaunay property is restored with local flips.
  *
- * DTDparams:	the DTDrawingParameters structure
- * start:		the start index of the slice
- * end:			the (excluded) end index of the slice
+ * delTri: 		the DelaunayTriangulation structure
+ * i_p: 		the index of the point, which must not be in the triangulation yet
+ *
+ * returns:		1 if the point was inserted, 0 otherwise (colinear points or not enough memory),
+ * 				in which case the triangulation must be computed again
  */
-void reDrawTriangulation(DTDrawingParameters *DTDparams,
-					 	 int start, int end) {
-
-	if (bov_window_should_close(DTDparams->window)) return;
-
-	// Get new lines
-	GLsizei n_lines = getDelaunayTriangulationNumberOfLines(DTDparams->delTri);
-
-
-	getDelaunayTriangulationLines(DTDparams->delTri, DTDparams->linesPoints, n_lines);
-
-	// Update lines
-	bov_points_update(DTDparams->linesDraw, DTDparams->linesPoints, 2 * n_lines);
-
-	if (DTDparams->FAST) {
-		bov_fast_lines_draw(DTDparams->window, DTDparams->linesDraw, 0, BOV_TILL_END);
-		bov_fast_points_draw(DTDparams->window, DTDparams->pointsDraw, 0, BOV_TILL_END);
-		bov_fast_points_draw(DTDparams->window, DTDparams->activePointsDraw, start, end);
-
-		for (GLsizei i = 0; i < DTDparams->n_divides; i++) {
-			if (DTDparams->divideLinesMask[i]) {
-				bov_fast_lines_draw(DTDparams->window, DTDparams->divideLinesDraw, 2 * i, 2 * i + 2);
+int insertPoint(DelaunayTriangulation *delTri, DTsize i_p) {
+	// Inspired from: Guibas & Stolfi (1985), InsertSite procedure
+	EdgeRef e, s, base, start;
+	DTsize n_stack = 0;
+	int outside;
+
+	delTri->version++;
+	e = getHintEdge(delTri);
+	if (e == EDGE_NULL) return 0;
+
+	e = locatePointFromEdge(delTri, delTri->points[i_p], e, &outside);
+	if (e == EDGE_NULL) return 0;
+
+	if (!outside) {
+		// Point already in the triangulation
+		s = e;
+		do {
+			if ((delTri->points[i_p][0] == delTri->points[ORIG(delTri, s)][0]) &&
+				(delTri->points[i_p][1] == delTri->points[ORIG(delTri, s)][1])) {
+				return 0;
+			}
+			s = LNEXT(delTri, s);
+		} while (s != e);
+
+		// Point on an edge of the triangle, the edge is removed
+		s = EDGE_NULL;
+		if 		(pointCompareEdge(delTri, i_p, e) == 0) s = e;
+		else if (pointCompareEdge(delTri, i_p, LNEXT(delTri, e)) == 0) s = LNEXT(delTri, e);
+		else if (pointCompareEdge(delTri, i_p, LPREV(delTri, e)) == 0) s = LPREV(delTri, e);
+
+		if (s != EDGE_NULL) {
+			if (isOuterFace(delTri, SYM(delTri, s))) {
+				// On the convex hull: the point now sees the two other edges from outside
+				e = LNEXT(delTri, s);
+				outside = 1;
+			}
+			else {
+				e = OPREV(delTri, s);
 			}
+			deleteEdge(delTri, s);
 		}
+	}
 
-		if (DTDparams->draw_circle) {
-				bov_fast_line_loop_draw(DTDparams->window, DTDparams->circlePointsDraw, 0, BOV_TILL_END);
-				bov_fast_points_draw_with_order(DTDparams->window, DTDparams->searchPointsDraw, DTDparams->searchPointsOrder, 0, BOV_TILL_END);
+	if (outside) {
+		// Connects the point to every point of the convex hull it sees
+		while (pointCompareEdge(delTri, i_p, LPREV(delTri, e)) == -1) {
+			e = LPREV(delTri, e);
 		}
+		base = addEdge(delTri, ORIG(delTri, e), i_p);
+		if (base == EDGE_NULL) return 0;
+		spliceEdges(delTri, base, e);
+
+		do {
+			s = LNEXT(delTri, e);
+			if (!pushEdge(delTri, &n_stack, e)) return 0;
+			base = connectEdges(delTri, e, SYM(delTri, base));
+			if (base == EDGE_NULL) return 0;
+			e = s;
+		} while (pointCompareEdge(delTri, i_p, e) == -1);
 	}
 	else {
-		bov_lines_draw(DTDparams->window, DTDparams->linesDraw, 0, BOV_TILL_END);
-		bov_points_draw(DTDparams->window, DTDparams->pointsDraw, 0, BOV_TILL_END);
-		bov_points_draw(DTDparams->window, DTDparams->activePointsDraw, start, end);
+		// Connects the point to every point of the face containing it
+		base = addEdge(delTri, ORIG(delTri, e), i_p);
+		if (base == EDGE_NULL) return 0;
+		spliceEdges(delTri, base, e);
+		start = base;
+
+		do {
+			if (!pushEdge(delTri, &n_stack, e)) return 0;
+			base = connectEdges(delTri, e, SYM(delTri, base));
+			if (base == EDGE_NULL) return 0;
+			e = OPREV(delTri, base);
+		} while (LNEXT(delTri, e) != start);
+		if (!pushEdge(delTri, &n_stack, e)) return 0;
+	}
+
+	delTri->hint = base;
+	return legalizeEdges(delTri, i_p, n_stack);
+}
 
-		for (GLsizei i = 0; i < DTDparams->n_divides; i++) {
-			if (DTDparams->divideLinesMask[i]) {
-				bov_lines_draw(DTDparams->window, DTDparams->divideLinesDraw, 2 * i, 2 * i + 2);
+/*
+ * Removes a point from an already computed triangulation: the edges of the
+ * point are deleted and the polygon formed by its neighbours is triangulated
+ * again by successively cutting Delaunay ears, i.e. triangles whose
+ * circumcircle contains no other point of the polygon. For a point on the
+ * convex hull, the polygon is open and ears are cut as long as they are convex.
+ * The point itself is not removed from the array of points.
+ *
+ * delTri: 		the DelaunayTriangulation structure
+ * i_p: 		the index of the point
+ *
+ * returns:		1 if the point was removed, 0 otherwise (degenerate case or not enough memory),
+ * 				in which case the triangulation must be computed again
+ */
+int removePoint(DelaunayTriangulation *delTri, DTsize i_p) {
+	EdgeRef e, start, a, b, d;
+	DTsize n_stack = 0, n, i, j, c;
+	int closed = 1, convex, ear;
+
+	if (getDelaunayTriangulationNumberOfPoints(delTri) <= 3) return 0;
+	delTri->version++;
+
+	e = getPointEdge(delTri, i_p);
+	if (e == EDGE_NULL) return 0;
+
+	// On the convex hull, the neighbours are taken from the edge after the outer face
+	start = e;
+	do {
+		if (isOuterFace(delTri, e)) {
+			closed = 0;
+			start = ONEXT(delTri, e);
+			break;
+		}
+		e = ONEXT(delTri, e);
+	} while (e != start);
+
+	// Stores the edges linking the neighbours, with the point on their left
+	e = start;
+	do {
+		if (!closed && (ONEXT(delTri, e) == start)) break;
+		if (isOuterFace(delTri, e)) return 0;
+		if (!pushEdge(delTri, &n_stack, LNEXT(delTri, e))) return 0;
+		e = ONEXT(delTri, e);
+	} while (e != start);
+
+	// Deletes the edges of the point
+	while (ONEXT(delTri, start) != start) {
+		deleteEdge(delTri, ONEXT(delTri, start));
+	}
+	deleteEdge(delTri, start);
+
+	// Cuts ears until the polygon is a triangle (or the convex hull)
+	n = n_stack;
+	while (n > (closed ? 3 : 1)) {
+		ear = 0;
+		convex = 1;
+		for (i = 0; i < (closed ? n : n - 1); i++) {
+			a = delTri->edge_stack[i];
+			b = delTri->edge_stack[(i + 1) % n];
+
+			if (pointCompareEdge(delTri, DEST(delTri, b), a) != -1) continue;
+
+			convex = 0;
+			ear = 1;
+			for (j = 0; (j <= n) && ear; j++) {
+				c = (j < n) ? ORIG(delTri, delTri->edge_stack[j]) : DEST(delTri, delTri->edge_stack[n - 1]);
+				if ((c == ORIG(delTri, a)) || (c == ORIG(delTri, b)) || (c == DEST(delTri, b))) continue;
+				ear = !pointInCircle(delTri, c, ORIG(delTri, a), ORIG(delTri, b), DEST(delTri, b));
 			}
+			if (ear) break;
 		}
+		if (!ear) {
+			// An open polygon is done once it is convex
+			if (closed || !convex) return 0;
+			break;
+		}
+
+		d = connectEdges(delTri, b, a);
+		if (d == EDGE_NULL) return 0;
 
-		if (DTDparams->draw_circle) {
-				bov_line_loop_draw(DTDparams->window, DTDparams->circlePointsDraw, 0, BOV_TILL_END);
-				bov_points_draw_with_order(DTDparams->window, DTDparams->searchPointsDraw, DTDparams->searchPointsOrder, 0, BOV_TILL_END);
+		// The ear is replaced by its new edge in the polygon
+		delTri->edge_stack[i] = SYM(delTri, d);
+		for (j = (i + 1) % n; j < n - 1; j++) {
+			delTri->edge_stack[j] = delTri->edge_stack[j + 1];
 		}
+		n--;
 	}
 
-	bov_window_update(DTDparams->window);
-	usleep(DTDparams->sleep);
+	delTri->hint = delTri->edge_stack[0];
+	return 1;
 }
 
 /*
- * Triangulates a set of points using the DelaunayTriangulation.
- * This function should be the main function which will all the other sub-functions.
+ * Moves a point of an already computed triangulation. If the point stays
+ * inside its star (and keeps the convex hull convex), the edges are kept and
+ * the Delaunay property is restored with local flips. Otherwise, the point is
+ * removed and inserted again at its new position.
+ *
+ * delTri: 		the DelaunayTriangulation structure
+ * i_p: 		the index of the point, at its old position
+ * point: 		the new position of the point
  *
- * DTDparams:	the DTDrawingParameters structure
+ * returns:		1 if the point was moved, 0 otherwise (degenerate case or not enough memory),
+ * 				in which case the triangulation must be computed again
  */
-void triangulateDTIllustrated(DTDrawingParameters *DTDparams) {
-	if (DTDparams->delTri->success) {
-	return;
-	}
-	if (DTDparams->delTri->n_points < 2) {
-		return;
+int movePoint(DelaunayTriangulation *delTri, DTsize i_p, DTfloat point[2]) {
+	EdgeRef e, g, start, hull = EDGE_NULL;
+	DTsize n_stack = 0;
+	int valid = 1;
+
+	delTri->version++;
+	start = getPointEdge(delTri, i_p);
+	if (start == EDGE_NULL) return 0;
+
+	// Stores the edges of the star, and finds the outer face (with the old position)
+	e = start;
+	do {
+		if (!pushEdge(delTri, &n_stack, e)) return 0;
+		if (isOuterFace(delTri, e)) {
+			hull = e;
+		}
+		else if (!pushEdge(delTri, &n_stack, LNEXT(delTri, e))) {
+			return 0;
+		}
+		e = ONEXT(delTri, e);
+	} while (e != start);
+
+	DTfloat old_point[2] = {delTri->points[i_p][0], delTri->points[i_p][1]};
+	delTri->points[i_p][0] = point[0];
+	delTri->points[i_p][1] = point[1];
+
+	// Every triangle of the star must keep its orientation
+	e = start;
+	do {
+		if ((e != hull) && (pointCompareEdge(delTri, i_p, LNEXT(delTri, e)) != -1)) {
+			valid = 0;
+		}
+		e = ONEXT(delTri, e);
+	} while ((e != start) && (valid));
+
+	// On the convex hull, the point and its two neighbours must stay convex
+	if ((valid) && (hull != EDGE_NULL)) {
+		g = LPREV(delTri, hull);
+		valid = (pointCompareEdge(delTri, DEST(delTri, hull), g) != -1) &&
+				(pointCompareEdge(delTri, DEST(delTri, LNEXT(delTri, hull)), hull) != -1) &&
+				(pointCompareEdge(delTri, i_p, LPREV(delTri, g)) != -1);
 	}
 
-	// Sort points by x coordinates then by y coordinate.
-	qsort(DTDparams->delTri->points, DTDparams->delTri->n_points, 2 * sizeof(GLfloat), compare_points);
+	if (valid) {
+		delTri->hint = start;
+		return flipEdges(delTri, n_stack);
+	}
 
-	DTDparams->draw_circle = 0;
-	reDrawTriangulation(DTDparams, 0, 0);
-	DTDparams->draw_circle = 1;
+	// The point left its star
+	delTri->points[i_p][0] = old_point[0];
+	delTri->points[i_p][1] = old_point[1];
+	if (!removePoint(delTri, i_p)) return 0;
 
-	/// Starts the triangulation using a divide and conquer approach.
-	Edge *l, *r;
-	triangulateIllustrated(DTDparams->delTri, 0, DTDparams->delTri->n_points, &l, &r, DTDparams);
-	DTDparams->delTri->success = 1;
+	delTri->points[i_p][0] = point[0];
+	delTri->points[i_p][1] = point[1];
+	return insertPoint(delTri, i_p);
 }
 
 /*
- * Recursive function used by the triangulateDT function in order to solve
- * the triangulation problem using a divide and conquer approach.
+ * Finds the triangle of an already computed triangulation containing a point,
+ * by walking from a hint edge (orient2d tests only). Starting from an edge
+ * close to the point, e.g. the result of the previous query, keeps the walk short.
  *
  * delTri: 		the DelaunayTriangulation structure
- * start:		the start index of the slice
- * end:			the (excluded) end index of the slice
- * el:			an Edge structure pointer for the left edge
- * er:			an Edge structure pointer for the right edge
- * DTDparams:	the DTDrawingParameters structure
+ * point: 		the point (x, y) to locate
+ * hint: 		the edge from which to start, EDGE_NULL to start from the hint of the triangulation
+ *
+ * returns:		an edge of the triangle (on its left) containing the point, which may lie on its edges,
+ * 				EDGE_NULL if the point is outside the convex hull or the triangulation is not computed
  */
-void triangulateIllustrated(DelaunayTriangulation *delTri, GLsizei start, GLsizei end, Edge **el, Edge **er,
-						    DTDrawingParameters *DTDparams) {
-	GLsizei n = end - start;
-	if (n == 2) {
-		// Creates an edge connecting the two points (start), (start + 1)
-		Edge *e = addEdge(delTri, start, start + 1);
-		*el = e;
-		*er = e->sym;
-		DTDparams->draw_circle = 0;
-		reDrawTriangulation(DTDparams, start, end);
-		DTDparams->draw_circle = 1;
-		return;
+EdgeRef locatePoint(DelaunayTriangulation *delTri, DTfloat point[2], EdgeRef hint) {
+	int outside;
+
+	if ((!delTri->success) || (isnan(point[0])) || (isnan(point[1]))) return EDGE_NULL;
+
+	if ((hint == EDGE_NULL) || (IS_DISCARDED(delTri, hint))) {
+		hint = getHintEdge(delTri);
+		if (hint == EDGE_NULL) return EDGE_NULL;
 	}
-	else if (n == 3) {
-		Edge *a, *b, *c;
 
-		// Creates two edges
-		// - a, connecting (start), 	(start + 1)
-		// - b, connecting (start + 1), (start + 2)
-		a = addEdge(delTri, start, 		start + 1);
-		b = addEdge(delTri, start + 1, 	start + 2);
-		spliceEdges(delTri, a->sym, b);
+	hint = locatePointFromEdge(delTri, point, hint, &outside);
+	if ((hint == EDGE_NULL) || (outside)) return EDGE_NULL;
+	return hint;
+}
 
-		int cmp = pointCompareEdge(delTri, start + 2, a);
+/*
+ * Finds the triangles of an already computed triangulation containing a batch
+ * of points. The points are visited along a Morton curve so that each walk
+ * starts from the triangle of a close point. If OpenMP is available, each
+ * thread handles a contiguous part of the curve.
+ *
+ * delTri: 		the DelaunayTriangulation structure
+ * points: 		the points (x, y) to locate
+ * n: 			the number of points
+ * triangles: 	the preallocated array that will contain the indices of the points of each
+ * 				triangle (counterclockwise), or -1 if the point is outside the convex hull
+ * n_threads: 	the number of threads to use, <= 0 to use all available threads
+ *
+ * returns:		1 on success, 0 if the triangulation is not computed or not enough memory
+ */
+int locatePoints(DelaunayTriangulation *delTri, DTfloat points[][2], DTsize n, DTsize triangles[][3], int n_threads) {
+	DTfloat bounds[2][2];
+	uint64_t *keys;
+	EdgeRef start;
 
-		setSearchPoints(DTDparams, a->orig, a->dest, b->dest);
+	if (!delTri->success) return 0;
+	if (n == 0) return 1;
 
-		// Now will close the triangle formed by the three points
-		if (cmp == 1) {
-			c = connectEdges(delTri, b, a);
-			*el = a;
-			*er = b->sym;
-			reDrawTriangulation(DTDparams, start, end);
-			return;
-		}
-		else if (cmp == -1) {
-			c = connectEdges(delTri, b, a);
-			*el = c->sym;
-			*er = c;
-			reDrawTriangulation(DTDparams, start, end);
-			return;
-		}
-		else {
-			*el = a;
-			*er = b->sym;
-			reDrawTriangulation(DTDparams, start, end);
-			return;
+	start = getHintEdge(delTri);
+	if (start == EDGE_NULL) return 0;
+
+	keys = malloc(sizeof(uint64_t) * n);
+	if (keys == NULL) {
+		printf("ERROR: Couldn't allocate memory for the points to locate\n");
+		return 0;
+	}
+
+	// Position of each point along the curve (16 bits per coordinate), followed by its index
+	getPointsBoudingBox(points, n, bounds);
+	double scale_x = (bounds[1][0] > bounds[0][0]) ? 65535.0 / ((double) bounds[1][0] - bounds[0][0]) : 0;
+	double scale_y = (bounds[1][1] > bounds[0][1]) ? 65535.0 / ((double) bounds[1][1] - bounds[0][1]) : 0;
+
+	for (DTsize i = 0; i < n; i++) {
+		uint32_t x = 0, y = 0;
+		if (!isnan(points[i][0])) {
+			x = (uint32_t) MIN((points[i][0] - bounds[0][0]) * scale_x, 65535);
+			y = (uint32_t) MIN((points[i][1] - bounds[0][1]) * scale_y, 65535);
 		}
+		keys[i] = ((uint64_t) mortonKey(x, y) << 32) | (uint32_t) i;
 	}
-	else {
-		// Recusively calls this function on half the points
-		GLsizei m = (n + 1) / 2;
-		Edge *ldo, *ldi, *rdi, *rdo;
-
-		GLsizei divide_index = addDivideLine(DTDparams, start + m);
-		DTDparams->draw_circle = 0;
-		reDrawTriangulation(DTDparams, start, end);
-		DTDparams->draw_circle = 1;
-
-		triangulateIllustrated(delTri, start, 		start + m, 	&ldo, &ldi, DTDparams);
-		triangulateIllustrated(delTri, start + m, 	end, 		&rdi, &rdo, DTDparams);
-		deleteDivideLine(DTDparams, divide_index);
-
-		// Computes the upper common tangent of left and right edges
-		while (1) {
-			setSearchPoints(DTDparams, rdi->orig, rdi->dest, ldi->dest);
-			if 		(pointCompareEdge(delTri, rdi->orig, ldi) ==  1) {
-				ldi = ldi->sym->onext;
-				reDrawTriangulation(DTDparams, start, end);
+	if (!sortKeys(keys, n, 32, n_threads)) {
+		free(keys);
+		return 0;
+	}
+
+#ifdef _OPENMP
+	if (n_threads <= 0) n_threads = omp_get_max_threads();
+#else
+	n_threads = 1;
+#endif
+
+	#pragma omp parallel num_threads(n_threads)
+	{
+		EdgeRef e, hint = start;
+		DTsize i;
+		int outside;
+
+		#pragma omp for schedule(static)
+		for (DTsize k = 0; k < n; k++) {
+			i = (DTsize) (uint32_t) keys[k];
+			e = EDGE_NULL;
+			if ((!isnan(points[i][0])) && (!isnan(points[i][1]))) {
+				e = locatePointFromEdge(delTri, points[i], hint, &outside);
 			}
-			else if (pointCompareEdge(delTri, ldi->orig, rdi) == -1) {
-				rdi = rdi->sym->oprev;
-				reDrawTriangulation(DTDparams, start, end);
+			if ((e == EDGE_NULL) || (outside)) {
+				triangles[i][0] = triangles[i][1] = triangles[i][2] = -1;
 			}
 			else {
-				break;
+				triangles[i][0] = ORIG(delTri, e);
+				triangles[i][1] = DEST(delTri, e);
+				triangles[i][2] = DEST(delTri, LNEXT(delTri, e));
 			}
+			// An edge of the convex hull is also a good start for the next point
+			if (e != EDGE_NULL) hint = e;
 		}
+	}
 
-		Edge *base;
-		DTDparams->draw_circle = 0;
-
-		// Creates an edge between rdi.orig and ldi.orig
-		base = connectEdges(delTri, ldi->sym, rdi);
-		reDrawTriangulation(DTDparams, start, end);
-
-		// Ajdusts ldo and rdo
-		if (ldi->orig == ldo->orig) {
-			ldo = base;
-			reDrawTriangulation(DTDparams, start, end);
-		}
-		if (rdi->orig == rdo->orig) {
-			rdo = base->sym;
-			reDrawTriangulation(DTDparams, start, end);
-		}
-		DTDparams->draw_circle = 1;
+	free(keys);
+	return 1;
+}
 
-		Edge *lcand, *rcand, *tmp;
-		int v_rcand, v_lcand;
+/*
+ * Renumbers the points of the DelaunayTriangulation along a Hilbert curve, and
+ * its edges by their first point, so that walking the triangulation (queries,
+ * extraction, Voronoi cells, ...) visits memory in order. The edges are
+ * compacted (the discarded edges are dropped) and the deleted points removed,
+ * ORIG, DEST and the links of the edges are remapped accordingly.
+ *
+ * Points are no longer sorted afterwards, so that a full triangulation will
+ * sort them again.
+ *
+ * delTri: 		the DelaunayTriangulation structure
+ * old_index:	the preallocated array of getDelaunayTriangulationNumberOfPoints(delTri)
+ *				indices that will contain, for each point, its index before the
+ *				renumbering, or NULL
+ * n_threads: 	the number of threads used to sort the points, <= 0 to use all available threads
+ *
+ * returns:		1 on success, 0 if there was not enough memory (nothing is changed)
+ */
+int renumberDelaunayTriangulation(DelaunayTriangulation *delTri, DTsize old_index[], int n_threads) {
+	DTsize n = getDelaunayTriangulationNumberOfPoints(delTri);
+	DTsize n_pairs = (delTri->n_edges - delTri->n_edges_discarded) / 2;
+	DTfloat bounds[2][2];
+
+	if (n <= 0) return 1;
+
+	uint64_t *keys = malloc(sizeof(uint64_t) * MAX(n, 1));
+	DTsize *new_index = malloc(sizeof(DTsize) * MAX(delTri->n_points, 1));
+	DTsize *new_edge = malloc(sizeof(DTsize) * MAX(delTri->n_edges, 1));
+	DTsize *first = calloc(n + 1, sizeof(DTsize));
+	Edge *edges = malloc(sizeof(Edge) * MAX(2 * n_pairs, 1));
+	DTfloat (*points)[2] = malloc(sizeof(points[0]) * MAX(n, 1));
+
+	if ((keys == NULL) || (new_index == NULL) || (new_edge == NULL) || (first == NULL) || (edges == NULL) || (points == NULL)) {
+		printf("ERROR: Couldn't allocate memory to renumber the triangulation\n");
+		free(keys); free(new_index); free(new_edge); free(first); free(edges); free(points);
+		return 0;
+	}
 
-		// We merge both parts
-		while (1) {
-			// Locates the first right and left points to be encountered
-			// by the diving bubble
+	// Position of each point along the curve (16 bits per coordinate), followed by its index
+	getPointsBoudingBox(delTri->points, delTri->n_points, bounds);
+	double scale_x = (bounds[1][0] > bounds[0][0]) ? 65535.0 / ((double) bounds[1][0] - bounds[0][0]) : 0;
+	double scale_y = (bounds[1][1] > bounds[0][1]) ? 65535.0 / ((double) bounds[1][1] - bounds[0][1]) : 0;
+
+	DTsize c = 0;
+	for (DTsize i = 0; i < delTri->n_points; i++) {
+		new_index[i] = -1;
+		if (POINT_DELETED(delTri, i)) continue;
+		uint32_t x = (uint32_t) MIN((delTri->points[i][0] - bounds[0][0]) * scale_x, 65535);
+		uint32_t y = (uint32_t) MIN((delTri->points[i][1] - bounds[0][1]) * scale_y, 65535);
+		keys[c++] = ((uint64_t) hilbertKey(x, y) << 32) | (uint32_t) i;
+	}
+	if (!sortKeys(keys, n, 32, n_threads)) {
+		free(keys); free(new_index); free(new_edge); free(first); free(edges); free(points);
+		return 0;
+	}
 
-			rcand = base->sym->onext;
-			lcand = base->oprev;
+	for (DTsize k = 0; k < n; k++) {
+		DTsize i = (DTsize) (uint32_t) keys[k];
+		new_index[i] = k;
+		points[k][0] = delTri->points[i][0];
+		points[k][1] = delTri->points[i][1];
+		if (old_index != NULL) old_index[k] = i;
+	}
+	memcpy(delTri->points, points, sizeof(points[0]) * n);
+
+	// Pairs of edges are sorted by the new index of their first point (counting sort)
+	EdgeRef e;
+	for (DTsize i = 0; i < delTri->n_edges; i += 2) {
+		e = EDGE_REF(delTri, i);
+		if (IS_DISCARDED(delTri, e)) continue;
+		first[MIN(new_index[ORIG(delTri, e)], new_index[DEST(delTri, e)]) + 1]++;
+	}
+	for (DTsize k = 0; k < n; k++) first[k + 1] += first[k];
+	for (DTsize i = 0; i < delTri->n_edges; i += 2) {
+		e = EDGE_REF(delTri, i);
+		new_edge[i] = new_edge[i + 1] = -1;
+		if (IS_DISCARDED(delTri, e)) continue;
+		DTsize pair = first[MIN(new_index[ORIG(delTri, e)], new_index[DEST(delTri, e)])]++;
+		new_edge[i] = 2 * pair;
+		new_edge[i + 1] = 2 * pair + 1;
+	}
 
-			v_rcand = (pointCompareEdge(delTri, rcand->dest, base) == 1);
-			v_lcand = (pointCompareEdge(delTri, lcand->dest, base) == 1);
+	// Edges are copied with their new indices, then written back in place
+	for (DTsize i = 0; i < delTri->n_edges; i++) {
+		if (new_edge[i] == -1) continue;
+		e = EDGE_REF(delTri, i);
+		Edge *edge = &edges[new_edge[i]];
+#if COMPACT_EDGES
+		edge->orig = new_index[ORIG(delTri, e)];
+		edge->onext = (EdgeRef) new_edge[EDGE_IDX(delTri, ONEXT(delTri, e))];
+		edge->oprev = (EdgeRef) new_edge[EDGE_IDX(delTri, OPREV(delTri, e))];
+#else
+		edge->orig = new_index[ORIG(delTri, e)];
+		edge->dest = new_index[DEST(delTri, e)];
+		edge->onext = EDGE_AT(delTri, new_edge[EDGE_IDX(delTri, ONEXT(delTri, e))]);
+		edge->oprev = EDGE_AT(delTri, new_edge[EDGE_IDX(delTri, OPREV(delTri, e))]);
+		edge->sym = EDGE_AT(delTri, new_edge[EDGE_IDX(delTri, SYM(delTri, e))]);
+		edge->idx = new_edge[i];
+		edge->discarded = 0;
+#endif
+	}
+	// A discarded hint has no new index
+	if ((delTri->hint != EDGE_NULL) && (new_edge[EDGE_IDX(delTri, delTri->hint)] != -1)) {
+		delTri->hint = EDGE_REF(delTri, new_edge[EDGE_IDX(delTri, delTri->hint)]);
+	}
+	else {
+		delTri->hint = EDGE_NULL;
+	}
 
-			if (!(v_rcand || v_lcand)) {
-				// Merge is done
-				break;
-			}
-			// Deletes right edges that fail the circle test
-			if (v_rcand) {
-				while ((pointCompareEdge(delTri, rcand->onext->dest, base) == 1) &&
-					   (pointInCircle(delTri, rcand->onext->dest, base->dest, base->orig, rcand->dest))
-				   )
-					   {
-						   tmp = rcand->onext;
-						   deleteEdge(delTri, rcand);
-						   rcand = tmp;
-						   setSearchPoints(DTDparams, base->dest, base->orig, rcand->dest);
-						   reDrawTriangulation(DTDparams, start, end);
-					   }
-			}
-			// Deletes left edges that fail the circle test
-			if (v_lcand) {
-				while ((pointCompareEdge(delTri, lcand->oprev->dest, base) == 1) &&
-					   (pointInCircle(delTri, lcand->oprev->dest, base->dest, base->orig, lcand->dest))
-				   )
-					   {
-						   tmp = lcand->oprev;
-						   deleteEdge(delTri, lcand);
-						   lcand = tmp;
-						   setSearchPoints(DTDparams, base->dest, base->orig, lcand->dest);
-						   reDrawTriangulation(DTDparams, start, end);
-					   }
-			}
+	for (DTsize i = 0; i < 2 * n_pairs; i++) {
+		*EDGE_AT(delTri, i) = edges[i];
+#if COMPACT_EDGES
+		SET_DISCARDED(delTri, (EdgeRef) i, 0);
+#endif
+	}
 
-			if ((!v_rcand) ||
-				(v_rcand && pointInCircle(delTri, lcand->dest, rcand->dest, rcand->orig, lcand->orig))
-			) {
+	delTri->n_points = n;
+	delTri->n_free_points = 0;
+	delTri->sorted = 0;
+	delTri->arranged = 0;
+	delTri->grid_nx = delTri->grid_ny = 0;
+	delTri->n_edges = 2 * n_pairs;
+	delTri->n_edges_discarded = 0;
+	delTri->free_edges = EDGE_NULL;
+	delTri->version++;
 
-				tmp = connectEdges(delTri, lcand, base->sym);
-				base = tmp;
-				setSearchPoints(DTDparams, rcand->dest, rcand->orig, lcand->orig);
-				reDrawTriangulation(DTDparams, start, end);
-			}
-			else {
-				tmp = connectEdges(delTri, base->sym, rcand->sym);
-				base = tmp;
-				setSearchPoints(DTDparams, rcand->dest, rcand->orig, lcand->orig);
-				reDrawTriangulation(DTDparams, start, end);
-			}
-		}
-		DTDparams->draw_circle = 0;
-		reDrawTriangulation(DTDparams, start, end);
-		DTDparams->draw_circle = 1;
-		*el = ldo;
-		*er = rdo;
-	}
+	free(keys); free(new_index); free(new_edge); free(first); free(edges); free(points);
+	return 1;
 }
 
-////////////////////////////
-// End: Drawing functions //
-////////////////////////////
+//////////////////////////////////
+// End: Triangulation functions //
+//////////////////////////////////
@@ -16,167 +16,307 @@
 #ifndef _DELAUNAY_H
 #define _DELAUNAY_H
 
-#include "BOV.h"
 #include "math.h"
 #include "predicates.h"
+#include <stdint.h>
+#include <float.h>
+#include <string.h>
 
-#ifdef _WIN32
-#include <Windows.h>
-#else
-#include <unistd.h>
+#ifdef _OPENMP
+#include <omp.h>
 #endif
 
+// Integer types of the library, the same as OpenGL's GLsizei and GLuint so that
+// the viewer can pass its arrays directly
+typedef int DTsize;
+typedef unsigned int DTuint;
+
 #define MIN(x,y) ((x<y)?x:y)
 #define MAX(x,y) ((x>y)?x:y)
 #define RAD2DEG(a) ((180*a)/M_PI)
 
 #define ROBUST 1		// If True, will use robust predicates but will add overhead (x1.3 slowdown)
 						// Non robust methods may caude problems with colinear (or close to) points
+#define ORIENT2D_FILTER_BOUND ((3.0 + 8.0 * DBL_EPSILON) * DBL_EPSILON / 2)	// Rounding error bounds of the determinants computed in
+#define INCIRCLE_FILTER_BOUND ((10.0 + 48.0 * DBL_EPSILON) * DBL_EPSILON / 2)	// double precision, relative to their permanent (Shewchuk)
+#ifndef COMPACT_EDGES
+#define COMPACT_EDGES 0	// If True, edges are stored as 32-bit indices (12 bytes per half edge instead of 40)
+#endif
+#ifndef DT_STATS
+#define DT_STATS 0	// If True, each DelaunayTriangulation counts the work done by its triangulation (slows down parallel triangulations)
+#endif
 #define MIN_DIST 1E-10 	// Minimim distance between two points (used to avoid placing multiple points at the same location)
-#define N_POINTS 100	// Number of points to draw in a circle
-
-// Define some colors
-
-#define RED_COLOR (GLfloat[4]) {1.0, 0.0, 0.0, 1.0}
-#define GREEN_COLOR (GLfloat[4]) {0.0, 1.0, 0.0, 1.0}
-#define BLUE_COLOR (GLfloat[4]) {0.0, 0.0, 1.0, 1.0}
-#define BLACK_COLOR (GLfloat[4]) {0.0, 0.0, 0.0, 1.0}
-#define WHITE_COLOR (GLfloat[4]) {1.0, 1.0, 1.0, 1.0}
-#define NONE_COLOR (GLfloat[4]) {0.0, 0.0, 0.0, 0.0}
-#define DARK_RED_COLOR (GLfloat[4]) {0.722, 0.163, 0.0, 1.0}
-#define MED_BLUE_COLOR (GLfloat[4]) {0.0, 0.565, 0.901, 1.0}
-#define MED_BLUE_COLOR_25 (GLfloat[4]) {0.0, 0.565, 0.901, 0.25}
-#define SEA_GREEN_COLOR (GLfloat[4]) {0.016, 0.73, 0.677, 1.0}
-#define SEA_GREEN_COLOR_75 (GLfloat[4]) {0.016, 0.73, 0.677, 0.75}
-
-#define BASIC_POINTS_COLOR BLACK_COLOR
-#define BASIC_POINTS_OUTLINE_COLOR (GLfloat[4]) {0.3, 0.12, 0.0, 0.25}
-#define VORONOI_POINTS_COLOR DARK_RED_COLOR
-#define VORONOI_POINTS_OUTLINE_COLOR (GLfloat[4]) {0.3, 0.12, 0.0, 0.25}
-#define ACTIVE_POINTS_COLOR DARK_RED_COLOR
-#define ACTIVE_POINTS_OUTLINE_COLOR (GLfloat[4]) {0.3, 1., 0.0, 0.25}
-#define SEARCHED_POINTS_COLOR MED_BLUE_COLOR
-#define MOUSE_POINTS_COLOR NONE_COLOR
-#define MOUSE_POINTS_OUTLINE_COLOR (GLfloat[4]) {0.3, 0.12, 0.0, 0.25}
-
-#define TRIANGULATION_LINES_COLOR BLACK_COLOR
-#define TRIANGULATION_LINES_OUTLINE_COLOR (GLfloat[4]) {0.3, 0.12, 0.0, 0.25}
-#define VORONOI_LINES_COLOR MED_BLUE_COLOR
-#define VORONOI_LINES_OUTLINE_COLOR MED_BLUE_COLOR_25
-#define DIVIDE_LINES_COLOR (GLfloat[4]) {1.0, 0.0, 0.0, 0.8}
-#define CIRCLE_LINES_COLOR MED_BLUE_COLOR
-
-// Define some widths
-
-#define BASIC_POINTS_WIDTH 0.01
-#define VORONOI_POINTS_WIDTH BASIC_POINTS_WIDTH
-#define ACTIVE_POINTS_WIDTH (2.0 * BASIC_POINTS_WIDTH)
-#define SEARCHED_POINTS_WIDTH (1.5 * BASIC_POINTS_WIDTH)
-#define MOUSE_POINTS_WIDTH 0.04
-
-#define TRIANGULATION_LINES_WIDTH 0.004
-#define VORONOI_LINES_WIDTH TRIANGULATION_LINES_WIDTH
-#define DIVIDE_LINES_WIDTH 0.002
-#define CIRCLE_LINES_WIDTH 0.004
 
+#define EDGE_CHUNK_BITS 14								// Edges are allocated by chunks of 2^EDGE_CHUNK_BITS (half) edges
+#define EDGE_CHUNK_SIZE (1 << EDGE_CHUNK_BITS)
+#define EDGE_CHUNK_MASK (EDGE_CHUNK_SIZE - 1)
+#define EDGE_AT(delTri, i) (&((delTri)->edge_chunks[(i) >> EDGE_CHUNK_BITS][(i) & EDGE_CHUNK_MASK]))
+#define EDGE_CHUNK_TABLE_MAX ((0x7fffffff >> EDGE_CHUNK_BITS) + 1)	// Number of chunks needed to address every DTsize index
+
+#define RADIX_BITS 11			// Points are sorted by digits of RADIX_BITS bits of their (x, y) key
+#define RADIX_SIZE (1 << RADIX_BITS)
+#define RADIX_MASK (RADIX_SIZE - 1)
+#define RADIX_PASSES ((64 + RADIX_BITS - 1) / RADIX_BITS)
+#define RADIX_MIN_POINTS 256	// Below this number of points, points are sorted with qsort
+#define RADIX_THREAD_GRAIN 65536	// Minimum number of points sorted by each thread
+
+#define POINT_DELETED(delTri, i) isnan((delTri)->points[i][0])	// Deleted points are kept as NaN until the next full triangulation
 
+#define GRID_POINTS_PER_CELL 2	// Average number of points in a cell of the grid used to find the closest point
+#define GRID_MAX_LOAD 8			// Above this average number of points in a cell (or of points outside the grid), the grid is built again
+
+#define PARALLEL_GRAIN 50000	// Below this number of points, triangulateDTParallel (and arrangePoints) work sequentially
+#define X_CUTS 0				// triangulateDT divides the points by their x coordinate only (default)
+#define ALTERNATING_CUTS 1		// triangulateDT alternates vertical and horizontal cuts (Dwyer), see arrangePoints
+#define CUT_AXIS_MIN_POINTS 256	// Below this number of points, ALTERNATING_CUTS alternate without looking at the points (see getCutAxis)
+#define DEFAULT_LEAF_SIZE 16	// Slices of at most this number of points are not halved (see triangulateLeaf)
+#define LEAF_SIZE_MAX 64		// Largest leaf size, bounds the stack memory of triangulateLeaf
+#define LEAF_EDGES (6 * LEAF_SIZE_MAX)	// (Half) edges of a leaf, a triangulation of n points has less than 3n edges
+#define EDGE_BLOCK_SIZE 2048	// (Half) edges claimed at once by a thread during a parallel triangulation,
+								// must divide EDGE_CHUNK_SIZE and be a multiple of 64
+
+#if COMPACT_EDGES
+
+// Edges are referred to by their (32-bit) index, the symetrical edge of an edge
+// is its neighbour in the pair allocated by addEdge, i.e. index ^ 1
 typedef struct Edge {
-    GLsizei orig, dest;     // indices of origin and destinations points
+    DTsize orig;           // index of origin point (destination is the origin of the symetrical edge)
+    DTuint onext, oprev;    // indices of next and previous edges
+} Edge;
+
+typedef DTuint EdgeRef;
+
+#define EDGE_NULL ((EdgeRef) -1)
+#define EDGE_REF(delTri, i) ((EdgeRef) (i))
+#define EDGE_IDX(delTri, e) ((DTsize) (e))
+#define ONEXT(delTri, e) (EDGE_AT(delTri, e)->onext)
+#define OPREV(delTri, e) (EDGE_AT(delTri, e)->oprev)
+#define SYM(delTri, e) ((e) ^ 1)
+#define ORIG(delTri, e) (EDGE_AT(delTri, e)->orig)
+#define DEST(delTri, e) (EDGE_AT(delTri, (e) ^ 1)->orig)
+// One bit per pair of edges, stored next to each chunk
+#define IS_DISCARDED(delTri, e) \
+	(((delTri)->edge_flags[(e) >> EDGE_CHUNK_BITS][((e) & EDGE_CHUNK_MASK) >> 6] >> (((e) >> 1) & 31)) & 1)
+#define SET_DISCARDED(delTri, e, v) do { \
+		DTuint *w_ = &((delTri)->edge_flags[(e) >> EDGE_CHUNK_BITS][((e) & EDGE_CHUNK_MASK) >> 6]); \
+		if (v) *w_ |= 1u << (((e) >> 1) & 31); else *w_ &= ~(1u << (((e) >> 1) & 31)); \
+	} while (0)
+
+#else
+
+typedef struct Edge {
+    DTsize orig, dest;     // indices of origin and destinations points
     struct Edge *onext, *oprev;    // next and previous edges
     struct Edge *sym;              // opposite edge
 
-    GLsizei idx;            // index of the edge
+    DTsize idx;            // index of the edge
 
     int discarded;          // 1 if the edge has to be discarded
 } Edge;
 
+typedef Edge* EdgeRef;
+
+#define EDGE_NULL NULL
+#define EDGE_REF(delTri, i) EDGE_AT(delTri, i)
+#define EDGE_IDX(delTri, e) ((e)->idx)
+#define ONEXT(delTri, e) ((e)->onext)
+#define OPREV(delTri, e) ((e)->oprev)
+#define SYM(delTri, e) ((e)->sym)
+#define ORIG(delTri, e) ((e)->orig)
+#define DEST(delTri, e) ((e)->dest)
+#define IS_DISCARDED(delTri, e) ((e)->discarded)
+#define SET_DISCARDED(delTri, e, v) ((e)->discarded = (e)->sym->discarded = (v))
+
+#endif
+
+// Next and previous edges around the left face of an edge
+#define LNEXT(delTri, e) OPREV(delTri, SYM(delTri, e))
+#define LPREV(delTri, e) SYM(delTri, ONEXT(delTri, e))
+
+// Edges of a leaf of the divide and conquer, triangulated in stack memory by
+// triangulateLeaf before being copied to the DelaunayTriangulation: the
+// symetrical edge of edge e is e ^ 1 (as with COMPACT_EDGES) and the points
+// are numbered from the first point of the leaf
+typedef struct LeafEdges {
+    uint16_t onext[LEAF_EDGES], oprev[LEAF_EDGES];
+    uint8_t orig[LEAF_EDGES];
+    int n_edges;
+} LeafEdges;
+
+#define LEAF_DEST(leaf, e) ((leaf)->orig[(e) ^ 1])
+#define LEAF_LNEXT(leaf, e) ((leaf)->oprev[(e) ^ 1])
+#define LEAF_LPREV(leaf, e) ((leaf)->onext[e] ^ 1)
+
+// Edges owned by one thread during a parallel triangulation, so that threads
+// never contend on n_edges nor on the list of discarded edges
+typedef struct EdgeArena {
+    DTsize next, end;			// unused (discarded) edges left in the last claimed block
+    DTsize n_edges_discarded;	// edges discarded by this thread, claimed blocks count as discarded
+    EdgeRef free_edges;			// discarded pairs of edges, ready to be reused by this thread
+} EdgeArena;
+
+#ifdef _OPENMP
+#define CURRENT_ARENA(delTri) (((delTri)->arenas == NULL) ? NULL : &((delTri)->arenas[omp_get_thread_num()]))
+#else
+#define CURRENT_ARENA(delTri) ((delTri)->arenas)
+#endif
+
+// Counters of the work done by a triangulation, cumulated since its allocation (only with DT_STATS)
+typedef struct DTStats {
+    unsigned long orient2d_calls, orient2d_exact;	// orientation tests, and those not decided by the floating-point filter
+    unsigned long incircle_calls, incircle_exact;	// in-circle tests, and those not decided by the floating-point filter
+    unsigned long edges_created, edges_deleted;		// pairs of (half) edges
+    unsigned long merge_steps;		// iterations of the merge loop of mergeTriangulations (one per edge created)
+    unsigned long tangent_steps;	// steps of the search of the upper common tangent in mergeTriangulations
+    unsigned long max_depth;		// depth of the divide and conquer recursion of the last triangulation
+} DTStats;
+
+#if DT_STATS
+#define DT_COUNT(delTri, counter) do { _Pragma("omp atomic") (delTri)->stats.counter++; } while (0)
+#else
+#define DT_COUNT(delTri, counter) do { (void) (delTri); } while (0)
+#endif
+
 typedef struct DelaunayTriangulation {
     // Success will be == 1 if triang. has been completed
     int success;
 
     // Keeping track of points
-    GLsizei n_points;
-    GLfloat (*points)[2];
+    DTsize n_points, n_points_max;
+    DTfloat (*points)[2];
+    int points_owned;		// 0 if the points are borrowed (see initDelaunayTriangulationInPlace), not freed nor reallocated
+    int sorted;				// 1 if the points are known to be sorted (x, then y)
+    int cuts;				// X_CUTS or ALTERNATING_CUTS, how triangulateDT divides the points
+    int arranged;			// leaf size of the arrangement for ALTERNATING_CUTS (see arrangePoints), then not sorted, 0 if not arranged
+    int leaf_size;			// slices of at most this number of points (3 to LEAF_SIZE_MAX) are triangulated without merges
 
-    // Edges
-    GLsizei n_edges, n_edges_discarded, n_edges_max;
-    Edge *edges;
+    // Indices of deleted points, reused when adding points
+    DTsize *free_points;
+    DTsize n_free_points, n_free_points_max;
+
+    // Uniform grid of the points, to find the closest point (built when first needed)
+    DTsize grid_nx, grid_ny;		// number of cells in each direction, 0 if the grid is not built
+    DTfloat grid_min[2], grid_inv_size;	// lower corner of the grid and inverse of the size of a cell
+    DTsize *grid_cells;			// first point of each cell, -1 if empty
+    DTsize *grid_next;				// next point in the same cell, for each point
+    DTsize grid_cells_max, grid_next_max;
+    DTsize grid_n_points, grid_n_outside;	// points in the grid, and those outside its bounds
+
+    // Edges, stored by chunks so that growing never moves them
+    DTsize n_edges, n_edges_discarded, n_edges_max;
+    DTsize n_edge_chunks, n_edge_chunks_max;
+    Edge **edge_chunks;
+#if COMPACT_EDGES
+    DTuint **edge_flags;	// discarded bit of each pair of edges, by chunk
+#endif
+    EdgeRef free_edges;		// discarded pairs of edges, linked with onext, ready to be reused
+    EdgeArena *arenas;		// one arena per thread, only set during a parallel triangulation
+    EdgeRef hint;			// edge from which point location starts walking
+
+    // Edges waiting to be checked when restoring the Delaunay property
+    EdgeRef *edge_stack;
+    DTsize edge_stack_max;
+
+    // Triangles of the triangulation (see updateTriangles), valid while triangles_version == version
+    unsigned long version;			// incremented whenever the triangulation is modified
+    unsigned long triangles_version;
+    DTsize n_triangles, n_triangles_max;
+    DTsize (*triangles)[3];			// counterclockwise indices of the points of each triangle
+    DTsize (*triangles_edges)[3];		// edge k of each triangle, from its point k to its point (k + 1) % 3
+    DTsize (*triangles_neighbors)[3];	// triangle on the other side of edge k of each triangle, -1 outside
+    DTsize *edges_triangle;			// triangle on the left of each (half) edge, -1 outside
+    DTsize edges_triangle_max;
+
+#if DT_STATS
+    DTStats stats;
+#endif
 
 } DelaunayTriangulation;
 
-typedef struct DTDrawingParameters {
-	DelaunayTriangulation *delTri;
-	bov_window_t *window;
-	GLfloat (*linesPoints)[2];
-	GLfloat cos_[N_POINTS];
-	GLfloat sin_[N_POINTS];
-	GLfloat circ[N_POINTS][2];
-	GLsizei searchPoints[3];
-	bov_points_t *pointsDraw, *activePointsDraw, *linesDraw;
-	bov_points_t *searchPointsDraw, *circlePointsDraw;
-	bov_order_t *searchPointsOrder;
-	GLfloat y_min, y_max;
-	int FAST, sleep, draw_circle;
-
-	GLsizei n_divides, n_divides_max;
-
-	GLfloat (*divideLinesPoints)[2];
-	char *divideLinesMask;
-	bov_points_t *divideLinesDraw;
-} DTDrawingParameters;
-
-DelaunayTriangulation* initDelaunayTriangulation(GLfloat points[][2], GLsizei n, int remove_duplicates);
+// Voronoi cells of the points, clipped to a rectangle (see getVoronoiCells)
+typedef struct VoronoiCells {
+    DTsize n_cells;			// one cell per point (delTri->n_points)
+    DTsize *offsets;		// n_cells + 1 offsets, the cell of point i is vertices[offsets[i]] to vertices[offsets[i + 1] - 1]
+    DTfloat (*vertices)[2];	// counterclockwise vertices of each cell, the first one is not repeated
+} VoronoiCells;
+
+DelaunayTriangulation* initDelaunayTriangulation(DTfloat points[][2], DTsize n, int remove_duplicates);
+DelaunayTriangulation* initDelaunayTriangulationInPlace(DTfloat points[][2], DTsize n, int sorted);
 void resetDelaunayTriangulation(DelaunayTriangulation *delTri);
-GLsizei getPointIndex(DelaunayTriangulation *delTri, GLfloat point[2]);
-GLfloat getDistanceToClosestPoint(DelaunayTriangulation *delTri, GLfloat point[2]);
-int addPoint(DelaunayTriangulation *delTri, GLfloat point[2]);
-int deletePointAtIndex(DelaunayTriangulation *delTri, GLsizei i_p);
-int deletePoint(DelaunayTriangulation *delTri, GLfloat point[2]);
+int buildPointGrid(DelaunayTriangulation *delTri);
+int getPointCell(DelaunayTriangulation *delTri, DTfloat point[2], DTsize cell[2]);
+void addPointToGrid(DelaunayTriangulation *delTri, DTsize i_p);
+void removePointFromGrid(DelaunayTriangulation *delTri, DTsize i_p);
+void getClosestPointInCell(DelaunayTriangulation *delTri, DTsize cx, DTsize cy, DTfloat point[2],
+						   DTsize *closest_idx, DTfloat *closest_dist);
+DTsize getPointIndex(DelaunayTriangulation *delTri, DTfloat point[2]);
+DTfloat getDistanceToClosestPoint(DelaunayTriangulation *delTri, DTfloat point[2]);
+int addPoint(DelaunayTriangulation *delTri, DTfloat point[2]);
+int insertPoint(DelaunayTriangulation *delTri, DTsize i_p);
+int deletePointAtIndex(DelaunayTriangulation *delTri, DTsize i_p);
+void updatePointAtIndex(DelaunayTriangulation *delTri, DTsize i_p, DTfloat point[2]);
+int removePoint(DelaunayTriangulation *delTri, DTsize i_p);
+int movePoint(DelaunayTriangulation *delTri, DTsize i_p, DTfloat point[2]);
+void compactPoints(DelaunayTriangulation *delTri);
+int deletePoint(DelaunayTriangulation *delTri, DTfloat point[2]);
 void freeDelaunayTriangulation(DelaunayTriangulation *delTri);
 void describeDelaunayTriangulation(DelaunayTriangulation *delTri);
-GLsizei getDelaunayTriangulationNumberOfLines(DelaunayTriangulation *delTri);
-void getDelaunayTriangulationLines(DelaunayTriangulation *delTri, GLfloat lines[][2], GLsizei n_lines);
-GLsizei getNumberOfTriangles(DelaunayTriangulation *delTri);
-void getVoronoiCentersAndNeighbors(DelaunayTriangulation *delTri, GLfloat centers[][2], GLsizei neighbors[][3], GLsizei n_triangles);
-void getVoronoiLines(DelaunayTriangulation *delTri, GLfloat centers[][2], GLsizei neighbors[][3], GLfloat lines[][2], GLsizei n_triangles);
+float getSmallestAngle(DelaunayTriangulation *delTri);
+DTsize getDelaunayTriangulationNumberOfPoints(DelaunayTriangulation *delTri);
+void getDelaunayTriangulationPoints(DelaunayTriangulation *delTri, DTfloat points[][2]);
+DTsize getDelaunayTriangulationNumberOfLines(DelaunayTriangulation *delTri);
+void getDelaunayTriangulationLines(DelaunayTriangulation *delTri, float lines[][2], DTsize n_lines);
+int updateTriangles(DelaunayTriangulation *delTri);
+DTsize getNumberOfTriangles(DelaunayTriangulation *delTri);
+DTsize getDelaunayTriangulationTriangles(DelaunayTriangulation *delTri, DTsize triangles[][3], DTsize neighbors[][3]);
+void getVoronoiCentersAndNeighbors(DelaunayTriangulation *delTri, float centers[][2], DTsize neighbors[][3], DTsize n_triangles);
+void getVoronoiLines(DelaunayTriangulation *delTri, float centers[][2], DTsize neighbors[][3], float lines[][2], DTsize n_triangles);
+VoronoiCells* getVoronoiCells(DelaunayTriangulation *delTri, DTfloat bounds[][2], int n_threads);
+void freeVoronoiCells(VoronoiCells *cells);
 void fsaveDelaunayTriangulation(DelaunayTriangulation *delTri, FILE* file_out) ;
 
-Edge* addEdge(DelaunayTriangulation *delTri, GLsizei orig, GLsizei dest);
-void describeEdge(Edge *e);
-void spliceEdges(DelaunayTriangulation *delTri, Edge *a, Edge *b);
-Edge* connectEdges(DelaunayTriangulation *delTri, Edge *a, Edge *b);
-void deleteEdge(DelaunayTriangulation *delTri, Edge *e);
-
-static int compare_points(const void *a_v, const void *b_v);
-void getPointsBoudingBox(GLfloat points[][2], GLsizei n_points, GLfloat bounds[][2]);
-int pointInCircle(DelaunayTriangulation *delTri, GLsizei i_p, GLsizei i_a, GLsizei i_b, GLsizei i_c);
-GLfloat circleCenter(DelaunayTriangulation *delTri, GLsizei i_a, GLsizei i_b, GLsizei i_c, GLfloat center[2]);
-int pointCompareEdge(DelaunayTriangulation *delTri, GLsizei i_p, Edge *e);
-GLfloat angleBetweenContiguousEdges(DelaunayTriangulation *delTri, Edge *e, Edge *f);
-
-void triangulateDT(DelaunayTriangulation *delTri);
-void triangulate(DelaunayTriangulation *delTri, GLsizei start, GLsizei end, Edge **el, Edge **er);
-
-void getMousePosition(bov_window_t *window, GLfloat mouse_pos[2]);
-void getInfoText(DelaunayTriangulation *delTri, char *info_text_char);
-void drawDelaunayTriangulation(DelaunayTriangulation *delTri, bov_window_t *window, double total_time);
-DTDrawingParameters* initDTDrawingParameters(DelaunayTriangulation *delTri,
-											 bov_window_t *window,
-						 					 GLfloat linesPoints[][2],
-						 					 bov_points_t *pointsDraw,
-											 bov_points_t *activePointsDraw,
-											 bov_points_t *linesDraw,
-											 GLfloat bounds[][2],
-						 					 int FAST, int sleep);
-void setSearchPoints(DTDrawingParameters *DTDparams,
-					 GLsizei i_a, GLsizei i_b ,GLsizei i_c);
-GLsizei addDivideLine(DTDrawingParameters *DTDparams, GLsizei pivot);
-void deleteDivideLine(DTDrawingParameters *DTDparams, GLsizei index);
-void freeDTDrawingParameters(DTDrawingParameters *DTDparams);
-void reDrawTriangulation(DTDrawingParameters *DTDparams,
-					 	 int start, int end);
-void triangulateDTIllustrated(DTDrawingParameters *DTDparams);
-void triangulateIllustrated(DelaunayTriangulation *delTri, GLsizei start, GLsizei end, Edge **el, Edge **er,
-						    DTDrawingParameters *DTDparams);
+int reserveEdgeChunkTable(DelaunayTriangulation *delTri, DTsize n_chunks);
+int reserveEdges(DelaunayTriangulation *delTri, DTsize n_edges);
+int claimEdgeBlock(DelaunayTriangulation *delTri, EdgeArena *arena);
+EdgeRef addEdge(DelaunayTriangulation *delTri, DTsize orig, DTsize dest);
+void describeEdge(DelaunayTriangulation *delTri, EdgeRef e);
+void spliceEdges(DelaunayTriangulation *delTri, EdgeRef a, EdgeRef b);
+EdgeRef connectEdges(DelaunayTriangulation *delTri, EdgeRef a, EdgeRef b);
+void deleteEdge(DelaunayTriangulation *delTri, EdgeRef e);
+void flipEdge(DelaunayTriangulation *delTri, EdgeRef e);
+int pushEdge(DelaunayTriangulation *delTri, DTsize *n_stack, EdgeRef e);
+int legalizeEdges(DelaunayTriangulation *delTri, DTsize i_p, DTsize n_stack);
+int flipEdges(DelaunayTriangulation *delTri, DTsize n_stack);
+EdgeRef getHintEdge(DelaunayTriangulation *delTri);
+int isOuterFace(DelaunayTriangulation *delTri, EdgeRef e);
+EdgeRef locatePointFromEdge(DelaunayTriangulation *delTri, DTfloat point[2], EdgeRef e, int *outside);
+EdgeRef getPointEdge(DelaunayTriangulation *delTri, DTsize i_p);
+EdgeRef locatePoint(DelaunayTriangulation *delTri, DTfloat point[2], EdgeRef hint);
+int locatePoints(DelaunayTriangulation *delTri, DTfloat points[][2], DTsize n, DTsize triangles[][3], int n_threads);
+int renumberDelaunayTriangulation(DelaunayTriangulation *delTri, DTsize old_index[], int n_threads);
+
+int pointsAreSorted(DTfloat points[][2], DTsize n_points);
+int sortKeys(uint64_t keys[], DTsize n_keys, int low_bit, int n_threads);
+void sortPoints(DTfloat points[][2], DTsize n_points, int n_threads);
+int arrangePoints(DTfloat points[][2], DTsize n_points, DTsize leaf_size, int n_threads);
+void getPointsBoudingBox(DTfloat points[][2], DTsize n_points, DTfloat bounds[][2]);
+int pointInCircle(DelaunayTriangulation *delTri, DTsize i_p, DTsize i_a, DTsize i_b, DTsize i_c);
+float circleCenter(DelaunayTriangulation *delTri, DTsize i_a, DTsize i_b, DTsize i_c, float center[2]);
+int pointCompareEdge(DelaunayTriangulation *delTri, DTsize i_p, EdgeRef e);
+int coordsCompareEdge(DelaunayTriangulation *delTri, DTfloat point[2], EdgeRef e);
+float angleBetweenContiguousEdges(DelaunayTriangulation *delTri, EdgeRef e, EdgeRef f);
+
+int preparePoints(DelaunayTriangulation *delTri, int n_threads);
+int triangulateDT(DelaunayTriangulation *delTri);
+unsigned long getRecursionDepth(DTsize n_points, DTsize leaf_size);
+int triangulate(DelaunayTriangulation *delTri, DTsize start, DTsize end, EdgeRef *el, EdgeRef *er);
+int triangulateLeaf(DelaunayTriangulation *delTri, DTsize start, DTsize end, EdgeRef *el, EdgeRef *er);
+EdgeRef getExtremeHullEdge(DelaunayTriangulation *delTri, EdgeRef e, int axis, int last);
+int triangulateBottomUp(DelaunayTriangulation *delTri, int n_threads, EdgeRef *el, EdgeRef *er);
+int mergeAlternating(DelaunayTriangulation *delTri, int axis, EdgeRef ldo, EdgeRef ldi, EdgeRef rdi, EdgeRef rdo,
+					 EdgeRef *el, EdgeRef *er);
+int mergeTriangulations(DelaunayTriangulation *delTri, EdgeRef ldo, EdgeRef ldi, EdgeRef rdi, EdgeRef rdo,
+						EdgeRef *el, EdgeRef *er);
+int triangulateDTParallel(DelaunayTriangulation *delTri, int n_threads, DTsize grain);
 
 #endif
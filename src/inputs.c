@@ -2,35 +2,35 @@
 
 /* fonction that outputs a random value, with a
  * probability following a gaussian curve */
-GLfloat random_gauss(GLfloat mu, GLfloat sigma)
+float random_gauss(float mu, float sigma)
 {
-	GLfloat u1, u2;
+	float u1, u2;
 	do {
-		u1 = (GLfloat) rand() / RAND_MAX;
-		u2 = (GLfloat) rand() / RAND_MAX;
+		u1 = (float) rand() / RAND_MAX;
+		u2 = (float) rand() / RAND_MAX;
 	} while (u1<1e-6);
 	return mu + sigma * sqrtf(-2.0f * logf(u1)) * cosf(2.0f * M_PI * u2);
 }
 
 
 /* fill coord with random coordinates following an uniform distribution */
-void random_uniform_points(GLfloat coord[][2], GLsizei n,
-                           GLfloat min[2], GLfloat max[2])
+void random_uniform_points(float coord[][2], DTsize n,
+                           float min[2], float max[2])
 {
-	for (GLsizei i=0; i<n; i++) {
+	for (DTsize i=0; i<n; i++) {
 		coord[i][0] = (max[0] - min[0]) * rand() / RAND_MAX + min[0];
 		coord[i][1] = (max[1] - min[1]) * rand() / RAND_MAX + min[1];
 	}
 }
 
 /* fill coord with random coordinates following an uniform distribution */
-void random_uniform_points_in_circle(GLfloat coord[][2], GLsizei n,
-                           GLfloat min[2], GLfloat max[2])
+void random_uniform_points_in_circle(float coord[][2], DTsize n,
+                           float min[2], float max[2])
 {
-	GLfloat a, b, x, y;
+	float a, b, x, y;
 	a = max[0] - min[0];
 	b = max[1] - min[1];
-	for (GLsizei i=0; i<n; i++) {
+	for (DTsize i=0; i<n; i++) {
 		do {
 			coord[i][0] = (max[0] - min[0]) * rand() / RAND_MAX + min[0];
 			coord[i][1] = (max[1] - min[1]) * rand() / RAND_MAX + min[1];
@@ -44,23 +44,23 @@ void random_uniform_points_in_circle(GLfloat coord[][2], GLsizei n,
 /* creating random points following a gaussian distribution.
  * around multiple centroid (maximum 6 centroids) which
  * are uniformly*/
-void random_points(GLfloat coord[][2], GLsizei n)
+void random_points(float coord[][2], DTsize n)
 {
 	int n_centroids = rand() % 6 + 1;
-	GLfloat (*centroids)[2] = malloc(sizeof(GLfloat) * n_centroids * 2);
-	GLfloat (*sigma)[2] = malloc(sizeof(GLfloat) * n_centroids * 2);
+	float (*centroids)[2] = malloc(sizeof(float) * n_centroids * 2);
+	float (*sigma)[2] = malloc(sizeof(float) * n_centroids * 2);
 
-	GLfloat range = 0.7 * (1.0 - 1.0 / n_centroids);
+	float range = 0.7 * (1.0 - 1.0 / n_centroids);
 	random_uniform_points(centroids, n_centroids,
-	                      (GLfloat[2]) {-range, -range},
-	                      (GLfloat[2]) { range,  range});
+	                      (float[2]) {-range, -range},
+	                      (float[2]) { range,  range});
 
-	for (GLsizei i=0; i<n_centroids; i++) {
+	for (DTsize i=0; i<n_centroids; i++) {
 		sigma[i][0] = 0.3f * rand() / RAND_MAX + 0.1f;
 		sigma[i][1] = 0.3f * rand() / RAND_MAX + 0.1f;
 	}
 
-	for (GLsizei i=0; i<n; i++) {
+	for (DTsize i=0; i<n; i++) {
 		for(int j=0; j<2; j++) {
 			coord[i][j] = random_gauss(centroids[i%n_centroids][j], sigma[i%n_centroids][j]);
 		}
@@ -72,9 +72,9 @@ void random_points(GLfloat coord[][2], GLsizei n)
 
 
 // see https://stackoverflow.com/questions/16542042
-static inline GLfloat pseudoangle(GLfloat dx, GLfloat dy)
+static inline float pseudoangle(float dx, float dy)
 {
-	GLfloat p = dx/(fabs(dx)+fabs(dy)); // -1 .. 1 increasing with x
+	float p = dx/(fabs(dx)+fabs(dy)); // -1 .. 1 increasing with x
 	if (dy<0.0f)
 		return 3.0f + p;  //  2 .. 4 increasing with x
 	else
@@ -89,27 +89,27 @@ static inline GLfloat pseudoangle(GLfloat dx, GLfloat dy)
  */
 static int compare_angle(const void *a_v, const void *b_v)
 {
-	GLfloat* a = *(GLfloat(*)[2]) a_v;
-	GLfloat* b = *(GLfloat(*)[2]) b_v;
+	float* a = *(float(*)[2]) a_v;
+	float* b = *(float(*)[2]) b_v;
 
-	GLfloat diff = pseudoangle(b[0], b[1]) - pseudoangle(a[0], a[1]);
+	float diff = pseudoangle(b[0], b[1]) - pseudoangle(a[0], a[1]);
 	return (diff>0) - (diff<0);
 }
 
 
 /* create a random polygon
  * the bigger nSmooth is, the rounder it will be  */
-void random_polygon(GLfloat coord[][2], GLsizei n, int nSmooth)
+void random_polygon(float coord[][2], DTsize n, int nSmooth)
 {
-	GLfloat sigmax = (GLfloat) rand() / RAND_MAX;
-	GLfloat sigmay = (GLfloat) rand() / RAND_MAX;
+	float sigmax = (float) rand() / RAND_MAX;
+	float sigmay = (float) rand() / RAND_MAX;
 
-	for(GLsizei i=0; i<n; i++) {
+	for(DTsize i=0; i<n; i++) {
 		coord[i][0] = random_gauss(0.0f, sigmax);
 		coord[i][1] = random_gauss(0.0f, sigmay);
 	}
 
-	qsort(coord, n, 2 * sizeof(GLfloat), compare_angle);
+	qsort(coord, n, 2 * sizeof(float), compare_angle);
 
 	// a little bit of smoothing
 	for(int smoothing=0; smoothing<nSmooth; smoothing++) {
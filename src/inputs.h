@@ -1,4 +1,4 @@
-#include "BOV.h"
+#include "delaunay.h"
 #include <math.h>
 
 #ifndef M_PI
@@ -7,20 +7,20 @@
 
 /* fonction that outputs a random value, with a
  * probability following a gaussian curve */
-GLfloat random_gauss(GLfloat mu, GLfloat sigma);
+float random_gauss(float mu, float sigma);
 
 /* fill coord with random coordinates following a uniform distribution */
-void random_uniform_points(GLfloat coord[][2], GLsizei n,
-                           GLfloat min[2], GLfloat max[2]);
+void random_uniform_points(float coord[][2], DTsize n,
+                           float min[2], float max[2]);
 
-void random_uniform_points_in_circle(GLfloat coord[][2], GLsizei n,
-                                     GLfloat min[2], GLfloat max[2]);
+void random_uniform_points_in_circle(float coord[][2], DTsize n,
+                                     float min[2], float max[2]);
 
 /* creating random points following a gaussian distribution.
  * around multiple centroid (maximum 6 centroids) which
  * are uniformly */
-void random_points(GLfloat coord[][2], GLsizei n);
+void random_points(float coord[][2], DTsize n);
 
 /* create a random polygon
  * the bigger nSmooth is, the rounder it will be  */
-void random_polygon(GLfloat coord[][2], GLsizei n, int nSmooth);
+void random_polygon(float coord[][2], DTsize n, int nSmooth);
@@ -14,7 +14,8 @@
  */
 
 #include "inputs.h"
-#include "delaunay.h"
+#include "viewer.h"
+#include "pointfile.h"
 #include <time.h>
 #ifdef _WIN32
 #include <Windows.h>
@@ -26,7 +27,7 @@
 #include <string.h>
 #include <getopt.h>
 
-#define OPTSTR "vi:i:o:n:p:s:a:b:t:di:yi:r:ui:x:h"
+#define OPTSTR "vi:i:o:w:m:f:gn:p:s:a:b:t:di:yi:r:ui:x:j:c:h"
 #define USAGE_FMT  "\
 Delaunay Triangulation.\n\
 Jérome Eertmans, 2020.\n\n\
@@ -42,9 +43,16 @@ Usage:\n\
 Options:\n\
 \t[-v verbose]                  adds some verbosity to the program execution\n\
 \t[-i input_file=NULL]          if present, will read points from this file where first line must be the number of points,\n\
-\t                              and the next lines must match format %%lf%%lf\n\
+\t                              and the next lines must match format %%lf%%lf (e.g. a file written with -o), or a binary point file\n\
+\t                              (see pointfile.h), text files are parsed with -j threads\n\
 \t[-o output_file=NULL]         if present, will save the last status of the DelaunayTriangulation, where the first line\n\
 \t                              will contain \"(n_points, n_lines_points)\", then all the points (first the points and, then, the line points)\n\
+\t[-w points_file=NULL]         if present, will save the sorted points in a binary point file after the triangulation,\n\
+\t                              which is then read without parsing (and without copy when using -r 0)\n\
+\t[-m mesh_file=NULL]           if present, will save the last triangulation as a mesh file (see pointfile.h): the points once,\n\
+\t                              then the triangles as triples of point indices\n\
+\t[-f mesh_format=text]         text or binary\n\
+\t[-g mesh_neighbors]           also saves the neighbors of each triangle in the mesh file\n\
 \t[-n number_of_points=50]      number of random points\n\
 \t[-p random_process=normal]    normal, uniform(-circle), or polygon\n\
 \t[-s smoothing_factor=4]       smoothing applied on random polygon \n\
@@ -56,6 +64,9 @@ Options:\n\
 \t[-r remove_duplicates=1]      removes duplicated points (will add overhead), you can disable it to improve performances\n\
 \t[-u microseconds]             prints the total time taken by the triangulation in microseconds\n\
 \t[-x number_of_points]         brenchmark code, alias to -n {number_of_points} -d -r 0 -u\n\
+\t[-j number_of_threads=1]      number of threads used by the triangulation, 0 to use all available threads\n\
+\t[-c cuts=x]                   x or alternating, divides the points by x only, or alternately by x and y (faster on large\n\
+\t                              inputs, see triangulateDT)\n\
 \t[-h]                          displays help and exits\n"
 #define ERR_FOPEN_INPUT  "fopen(input, r)"
 #define ERR_FOPEN_OUTPUT "fopen(output, w)"
@@ -72,6 +83,10 @@ typedef struct options_t {
 	int v;
 	char *i;
 	char *o;
+	char *w;
+	char *m;
+	char *f;
+	int g;
 	int n;
 	int s;
 	char *p;
@@ -81,6 +96,8 @@ typedef struct options_t {
 	int d;
 	int r;
 	int u;
+	int j;
+	int c;
 } options_t;
 
 
@@ -93,6 +110,10 @@ int main(int argc, char *argv[])
 		0,			// Verbosity
 		NULL,		// Input file
 		NULL,		// Output file
+		NULL,		// Binary points file
+		NULL,		// Mesh file
+		"text",		// Mesh file format
+		0,			// No neighbors in mesh file
 		50,			// Number of points
 		4,			// Smoothing factor
 		"normal",	// Random process
@@ -102,6 +123,8 @@ int main(int argc, char *argv[])
 		0,			// By default, we draw
 		1,			// We remove duplicates
 		0,			// No timing in microseconds
+		1,			// Sequential triangulation
+		X_CUTS,		// Divide by x only
 	};
 
 	// Inspired from:
@@ -143,6 +166,26 @@ int main(int argc, char *argv[])
 			case 'o':
 				options.o = optarg;
 				break;
+			case 'w':
+				options.w = optarg;
+				break;
+			case 'm':
+				options.m = optarg;
+				break;
+			case 'f':
+				if ((strcmp(optarg, "text") != 0) && (strcmp(optarg, "binary") != 0)) {
+					printf("Unknown mesh format: %s\n"
+						   "Please choose one among:\n"
+						   "\t- text\n"
+						   "\t- binary\n",
+						   optarg);
+					exit(EXIT_FAILURE);
+				}
+				options.f = optarg;
+				break;
+			case 'g':
+				options.g = 1;
+				break;
 			case 'a':
 				options.a = strtod(optarg, NULL);
 				break;
@@ -169,6 +212,25 @@ int main(int argc, char *argv[])
 				options.d = 1;
 				options.r = 0;
 				break;
+			case 'j':
+				options.j = atoi(optarg);
+				break;
+			case 'c':
+				if (strcmp(optarg, "x") == 0) {
+					options.c = X_CUTS;
+				}
+				else if (strcmp(optarg, "alternating") == 0) {
+					options.c = ALTERNATING_CUTS;
+				}
+				else {
+					printf("Unknown cuts: %s\n"
+						   "Please choose one among:\n"
+						   "\t- x\n"
+						   "\t- alternating\n",
+						   optarg);
+					exit(EXIT_FAILURE);
+				}
+				break;
 			case 'v':
 				options.v = 1;
 				break;
@@ -198,55 +260,56 @@ int main(int argc, char *argv[])
 	if (options.v) printf("seed=%d\n", seed);
 
 	GLsizei n_points;
-	GLfloat (*points)[2];
-
-	double x, y;
+	DTfloat (*points)[2] = NULL;
+	PointFile *point_file = NULL;
 
-	if (options.i != NULL) {
-		FILE *file_in = fopen(options.i, "r");
-		if (file_in == NULL) {
-			printf("ERROR: File %s not found\n", options.i);
+	if ((options.i != NULL) && (isPointFile(options.i))) {
+		point_file = openPointFile(options.i);
+		if (point_file == NULL) {
 			exit(EXIT_FAILURE);
 		}
-		char useless[256];
-		if (fscanf(file_in, "%d%[^\n]\n", &n_points, useless) == 0) {
-			printf("ERROR: First line doesn't match  %%d format\n");
+		n_points = point_file->n_points;
+	}
+	else if (options.i != NULL) {
+		point_file = openTextPointFile(options.i, options.j);
+		if (point_file == NULL) {
 			exit(EXIT_FAILURE);
 		}
-
-		points = malloc(sizeof(points[0]) * n_points);
-
-		for (GLsizei i = 0; i < n_points; i++) {
-			if (fscanf(file_in, "%lf %lf", &x, &y) != 2) {
-				printf("ERROR: Line %d could not parse x[%d], y[%d]\n", i+1, i, i);
-				exit(EXIT_FAILURE);
-			}
-			points[i][0] = (GLfloat) x;
-			points[i][1] = (GLfloat) y;
-		}
-
-		fclose(file_in);
+		n_points = point_file->n_points;
 	}
 	else {
 		n_points = (GLsizei) options.n;
-		points = malloc(sizeof(points[0]) * n_points);
+
+		// Random points are generated as GLfloat
+		GLfloat (*random)[2] = malloc(sizeof(random[0]) * n_points);
 
 		if (strcmp(options.p, "normal") == 0) {
-			random_points(points, n_points);
+			random_points(random, n_points);
 		}
 		else if (strcmp(options.p, "uniform") == 0) {
 			GLfloat min[2] = {0.0, 0.0};
 			GLfloat max[2] = {options.a, options.b};
-			random_uniform_points(points, n_points, min, max);
+			random_uniform_points(random, n_points, min, max);
 		}
 		else if (strcmp(options.p, "uniform-circle") == 0) {
 			GLfloat min[2] = {0.0, 0.0};
 			GLfloat max[2] = {options.a, options.b};
-			random_uniform_points_in_circle(points, n_points, min, max);
+			random_uniform_points_in_circle(random, n_points, min, max);
 		}
 		else if (strcmp(options.p, "polygon") == 0) {
-			random_polygon(points, n_points, options.s);
+			random_polygon(random, n_points, options.s);
 		}
+
+#if DOUBLE_PRECISION
+		points = malloc(sizeof(points[0]) * n_points);
+		for (GLsizei i = 0; i < n_points; i++) {
+			points[i][0] = random[i][0];
+			points[i][1] = random[i][1];
+		}
+		free(random);
+#else
+		points = random;
+#endif
 	}
 
 	if (options.v) printf("[STEP 2] DelaunayTriangulation\n");
@@ -256,7 +319,16 @@ int main(int argc, char *argv[])
 	clock_t u_time = clock();
 	clock_t begin = clock();
 
-	delTri = initDelaunayTriangulation(points, n_points, options.r);
+	if ((point_file != NULL) && (!options.r)) {
+		// The points of the file (mapped or parsed) are used as is
+		delTri = initDelaunayTriangulationInPlace(point_file->points, n_points, point_file->sorted);
+	}
+	else if (point_file != NULL) {
+		delTri = initDelaunayTriangulation(point_file->points, n_points, options.r);
+	}
+	else {
+		delTri = initDelaunayTriangulation(points, n_points, options.r);
+	}
 
 	if (options.v) {
 		printf("DelaunayTriangulation structure was allocated in %.6f s.\n",
@@ -265,7 +337,13 @@ int main(int argc, char *argv[])
 
 	begin = clock();
 
-	triangulateDT(delTri);
+	delTri->cuts = options.c;
+	if (options.j == 1) {
+		triangulateDT(delTri);
+	}
+	else {
+		triangulateDTParallel(delTri, options.j, 0);
+	}
 
 	if (options.v) {
 		printf("DelaunayTriangulation was computed in %.6f s.\n",
@@ -276,6 +354,10 @@ int main(int argc, char *argv[])
 		printf("%ld\n", clock() - begin);
 	}
 
+	if ((options.w != NULL) && (delTri->success)) {
+		savePointFile(options.w, delTri->points, delTri->n_points, delTri->sorted);
+	}
+
 	if (options.v) describeDelaunayTriangulation(delTri);
 
 	if (options.v) printf("[STEP 3] Drawing\n");
@@ -311,10 +393,15 @@ int main(int argc, char *argv[])
 		fclose(file_out);
 	}
 
+	if (options.m != NULL) {
+		saveMeshFile(options.m, delTri, strcmp(options.f, "binary") == 0, options.g);
+	}
+
 	freeDelaunayTriangulation(delTri);
 	if (options.v) printf("DelaunayTriangulation structure freed.\n");
 
-	free(points);
+	if (points != NULL) free(points);
+	closePointFile(point_file);
 
 	return EXIT_SUCCESS;
 }
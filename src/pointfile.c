@@ -0,0 +1,793 @@
+/*
+ * Binary point files of the Delaunay triangulation program, read with mmap.
+ *
+ * Author: 	Jerome Eertmans
+ * Context: project for the LMECA2710 course, at EPL faculty UCLouvain,
+ *			given by Pr. Vincent Legat and Pr. Jean-Francois Remacle.
+ *
+ * All sources of inspiration are clearly marked at specific places in the code.
+ * Feel free to use and re-use this code! No attribution but the ones for BOV.h,
+ * predicates.h and the sound files are required.
+ *
+ * Any contribution is welcome on the Github this project:
+ * https://github.com/jeertmans/DelaunayTriangulation
+ */
+
+#include "pointfile.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+/*
+ * Indicates whether a file is a point file, i.e. starts with POINT_FILE_MAGIC.
+ *
+ * filename:	the name of the file
+ *
+ * returns:		1 if the file is a point file, 0 otherwise (or if it cannot be opened)
+ */
+int isPointFile(const char *filename) {
+	char magic[8];
+	FILE *file = fopen(filename, "rb");
+	if (file == NULL) return 0;
+	int is_point_file = (fread(magic, 1, 8, file) == 8) && (memcmp(magic, POINT_FILE_MAGIC, 8) == 0);
+	fclose(file);
+	return is_point_file;
+}
+
+/*
+ * Checks the header of a point file against the size of the file.
+ *
+ * header:		the header
+ * size:		the size of the file, in bytes
+ *
+ * returns:		1 if the header is valid, 0 otherwise
+ */
+static int checkPointFileHeader(PointFileHeader *header, uint64_t size) {
+	if (memcmp(header->magic, POINT_FILE_MAGIC, 8) != 0) {
+		printf("ERROR: Not a point file (wrong magic)\n");
+		return 0;
+	}
+	if (header->version != POINT_FILE_VERSION) {
+		printf("ERROR: Unsupported point file version %u\n", header->version);
+		return 0;
+	}
+	if ((header->precision != 4) && (header->precision != 8)) {
+		printf("ERROR: Unsupported point file precision of %u bytes\n", header->precision);
+		return 0;
+	}
+	if (header->n_points > 0x7fffffff) {
+		printf("ERROR: Too many points in point file (%llu)\n", (unsigned long long) header->n_points);
+		return 0;
+	}
+	if (size < sizeof(PointFileHeader) + 2 * header->precision * header->n_points) {
+		printf("ERROR: Point file is truncated\n");
+		return 0;
+	}
+	return 1;
+}
+
+/*
+ * Opens a point file (see pointfile.h). On POSIX systems, the file is mapped
+ * privately: the points are only read from disk when they are accessed, and
+ * modifying them (e.g. by sorting) never modifies the file. If the precision
+ * of the file differs from DTfloat's, the points are converted into memory.
+ *
+ * The points can be given to initDelaunayTriangulationInPlace, the file must
+ * then be closed after the DelaunayTriangulation is freed.
+ *
+ * filename:	the name of the file
+ *
+ * returns:		the opened PointFile, NULL if it could not be read
+ */
+PointFile* openPointFile(const char *filename) {
+	PointFile *file = malloc(sizeof(PointFile));
+	if (file == NULL) {
+		printf("ERROR: Couldn't allocate memory for point file %s\n", filename);
+		return NULL;
+	}
+	file->map = NULL;
+	file->map_size = 0;
+	file->points = NULL;
+
+#ifndef _WIN32
+	int fd = open(filename, O_RDONLY);
+	if (fd == -1) {
+		printf("ERROR: File %s not found\n", filename);
+		free(file);
+		return NULL;
+	}
+
+	struct stat st;
+	if ((fstat(fd, &st) == -1) || ((uint64_t) st.st_size < sizeof(PointFileHeader))) {
+		printf("ERROR: Point file %s is too small\n", filename);
+		close(fd);
+		free(file);
+		return NULL;
+	}
+
+	file->map_size = (size_t) st.st_size;
+	file->map = mmap(NULL, file->map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (file->map == MAP_FAILED) {
+		printf("ERROR: Couldn't map point file %s\n", filename);
+		free(file);
+		return NULL;
+	}
+
+	memcpy(&file->header, file->map, sizeof(PointFileHeader));
+	if (!checkPointFileHeader(&file->header, file->map_size)) {
+		munmap(file->map, file->map_size);
+		free(file);
+		return NULL;
+	}
+
+	char *data = (char*) file->map + sizeof(PointFileHeader);
+	uint64_t n = file->header.n_points;
+
+	if (file->header.precision == sizeof(DTfloat)) {
+		file->points = (DTfloat (*)[2]) data;
+	}
+	else {
+		file->points = malloc(sizeof(file->points[0]) * n);
+		if ((file->points == NULL) && (n > 0)) {
+			printf("ERROR: Couldn't allocate memory for the points of %s\n", filename);
+			munmap(file->map, file->map_size);
+			free(file);
+			return NULL;
+		}
+		for (uint64_t i = 0; i < 2 * n; i++) {
+			if (file->header.precision == 4) file->points[0][i] = (DTfloat) ((float*) data)[i];
+			else file->points[0][i] = (DTfloat) ((double*) data)[i];
+		}
+		munmap(file->map, file->map_size);
+		file->map = NULL;
+	}
+#else
+	FILE *file_in = fopen(filename, "rb");
+	if (file_in == NULL) {
+		printf("ERROR: File %s not found\n", filename);
+		free(file);
+		return NULL;
+	}
+
+	fseek(file_in, 0, SEEK_END);
+	uint64_t size = (uint64_t) _ftelli64(file_in);
+	fseek(file_in, 0, SEEK_SET);
+
+	if ((fread(&file->header, sizeof(PointFileHeader), 1, file_in) != 1) ||
+		(!checkPointFileHeader(&file->header, size))) {
+		fclose(file_in);
+		free(file);
+		return NULL;
+	}
+
+	uint64_t n = file->header.n_points;
+	file->points = malloc(sizeof(file->points[0]) * n);
+	if ((file->points == NULL) && (n > 0)) {
+		printf("ERROR: Couldn't allocate memory for the points of %s\n", filename);
+		fclose(file_in);
+		free(file);
+		return NULL;
+	}
+
+	for (uint64_t i = 0; i < 2 * n; i++) {
+		float f;
+		double d;
+		if (file->header.precision == 4) {
+			if (fread(&f, 4, 1, file_in) != 1) break;
+			file->points[0][i] = (DTfloat) f;
+		}
+		else {
+			if (fread(&d, 8, 1, file_in) != 1) break;
+			file->points[0][i] = (DTfloat) d;
+		}
+	}
+	fclose(file_in);
+#endif
+
+	file->n_points = (DTsize) n;
+	file->sorted = (file->header.flags & POINT_FILE_SORTED) != 0;
+	return file;
+}
+
+/*
+ * Closes a point file, unmapping (or freeing) its points.
+ *
+ * file:		the PointFile
+ */
+void closePointFile(PointFile *file) {
+	if (file == NULL) return;
+#ifndef _WIN32
+	if (file->map != NULL) {
+		munmap(file->map, file->map_size);
+	}
+	else
+#endif
+	free(file->points);
+	free(file);
+}
+
+/*
+ * Saves points in a point file (see pointfile.h), with the precision of
+ * DTfloat.
+ *
+ * filename:	the name of the file
+ * points:		the n_points x 2 array of points
+ * n_points:	the number of points
+ * sorted:		if set, the points are sorted as sortPoints does (e.g. the
+ *				points of a DelaunayTriangulation after its triangulation)
+ *
+ * returns:		1 if the file was written, 0 otherwise
+ */
+int savePointFile(const char *filename, DTfloat points[][2], DTsize n_points, int sorted) {
+	PointFileHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, POINT_FILE_MAGIC, 8);
+	header.version = POINT_FILE_VERSION;
+	header.precision = sizeof(DTfloat);
+	header.n_points = (uint64_t) n_points;
+	header.flags = sorted ? POINT_FILE_SORTED : 0;
+
+	DTfloat bounds[2][2] = {{0.0, 0.0}, {0.0, 0.0}};
+	getPointsBoudingBox(points, n_points, bounds);
+	for (int i = 0; i < 2; i++) {
+		header.bounds[i][0] = bounds[i][0];
+		header.bounds[i][1] = bounds[i][1];
+	}
+
+	FILE *file_out = fopen(filename, "wb");
+	if (file_out == NULL) {
+		printf("ERROR: Couldn't open file %s in write mode.\n", filename);
+		return 0;
+	}
+
+	int ok = (fwrite(&header, sizeof(header), 1, file_out) == 1) &&
+			 (fwrite(points, sizeof(points[0]), n_points, file_out) == (size_t) n_points);
+	if (!ok) printf("ERROR: Couldn't write points to file %s\n", filename);
+
+	fclose(file_out);
+	return ok;
+}
+
+// Begin: text point files //
+
+#define TEXT_CHUNK_MIN_SIZE (1 << 20)	// Files smaller than this are parsed by one thread
+#define TEXT_NUMBER_MAX_LENGTH 128		// Longer numbers are considered as errors
+
+// Powers of ten that are exactly representable as doubles
+static const double exact_powers_of_ten[23] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/*
+ * Parses a decimal number ([+-]digits[.digits][(e|E)[+-]digits]) without any
+ * locale or scanf overhead, with the same result as (DTfloat) strtod.
+ *
+ * When the digits fit in a double and the exponent is small, the number is
+ * the correctly rounded quotient (or product) of two exact doubles
+ * (Clinger's fast path). Otherwise, in single precision, the approximation
+ * is used if it is far enough from a rounding boundary of float. In any other
+ * case, the number is given to strtod.
+ *
+ * s:			the first character of the number
+ * end:			the end of the text
+ * value:		the parsed number
+ *
+ * returns:		the character following the number, NULL if it is not a number
+ */
+static const char* parseTextNumber(const char *s, const char *end, DTfloat *value) {
+	const char *start = s;
+	int negative = 0;
+	if ((s < end) && ((*s == '-') || (*s == '+'))) {
+		negative = (*s == '-');
+		s++;
+	}
+
+	uint64_t mantissa = 0;
+	int n_digits = 0, exponent = 0, any_digit = 0, truncated = 0;
+
+	while ((s < end) && ((unsigned) (*s - '0') < 10)) {
+		if (n_digits < 19) {
+			mantissa = 10 * mantissa + (uint64_t) (*s - '0');
+			if (mantissa != 0) n_digits++;
+		}
+		else {
+			truncated |= (*s != '0');
+			exponent++;
+		}
+		any_digit = 1;
+		s++;
+	}
+	if ((s < end) && (*s == '.')) {
+		s++;
+		while ((s < end) && ((unsigned) (*s - '0') < 10)) {
+			if (n_digits < 19) {
+				mantissa = 10 * mantissa + (uint64_t) (*s - '0');
+				if (mantissa != 0) n_digits++;
+				exponent--;
+			}
+			else {
+				truncated |= (*s != '0');
+			}
+			any_digit = 1;
+			s++;
+		}
+	}
+	if (!any_digit) return NULL;
+
+	if ((s < end) && ((*s == 'e') || (*s == 'E'))) {
+		s++;
+		int negative_exponent = 0;
+		if ((s < end) && ((*s == '-') || (*s == '+'))) {
+			negative_exponent = (*s == '-');
+			s++;
+		}
+		if ((s == end) || ((unsigned) (*s - '0') >= 10)) return NULL;
+		int e = 0;
+		while ((s < end) && ((unsigned) (*s - '0') < 10)) {
+			if (e < 100000) e = 10 * e + (*s - '0');
+			s++;
+		}
+		exponent += negative_exponent ? -e : e;
+	}
+
+	if ((exponent >= -22) && (exponent <= 22)) {
+		double m = (double) mantissa;
+		double x = (exponent < 0) ? m / exact_powers_of_ten[-exponent] : m * exact_powers_of_ten[exponent];
+		if (!truncated && (mantissa <= ((uint64_t) 1 << 53))) {
+			*value = (DTfloat) (negative ? -x : x);
+			return s;
+		}
+#if !DOUBLE_PRECISION
+		// At most a few ulps of double away from the exact value
+		double low = x * (1.0 - 4.0 * DBL_EPSILON);
+		double high = x * (1.0 + 4.0 * DBL_EPSILON) + DBL_MIN;
+		if ((float) low == (float) high) {
+			*value = (DTfloat) (negative ? -x : x);
+			return s;
+		}
+#endif
+	}
+
+	// Slow path, strtod needs a null-terminated copy (the file is not)
+	char buffer[TEXT_NUMBER_MAX_LENGTH];
+	if (s - start >= TEXT_NUMBER_MAX_LENGTH) return NULL;
+	memcpy(buffer, start, (size_t) (s - start));
+	buffer[s - start] = '\0';
+	*value = (DTfloat) strtod(buffer, NULL);
+	return s;
+}
+
+/*
+ * Parses one line of a text point file: two numbers separated by spaces or
+ * tabs. Empty lines are skipped.
+ *
+ * s:			the first character of the line
+ * end:			the end of the text
+ * point:		the parsed point
+ * status:		set to 1 if a point was parsed, 0 if the line is empty, -1 on error
+ *
+ * returns:		the first character of the next line
+ */
+static const char* parseTextLine(const char *s, const char *end, DTfloat point[2], int *status) {
+	while ((s < end) && ((*s == ' ') || (*s == '\t'))) s++;
+
+	if ((s == end) || (*s == '\n') || (*s == '\r')) {
+		*status = 0;
+	}
+	else {
+		*status = -1;
+		s = parseTextNumber(s, end, &point[0]);
+		if ((s != NULL) && (s < end) && ((*s == ' ') || (*s == '\t'))) {
+			while ((s < end) && ((*s == ' ') || (*s == '\t'))) s++;
+			s = parseTextNumber(s, end, &point[1]);
+			if (s != NULL) {
+				while ((s < end) && ((*s == ' ') || (*s == '\t') || (*s == '\r'))) s++;
+				if ((s == end) || (*s == '\n')) *status = 1;
+			}
+		}
+		if (*status == -1) return NULL;
+	}
+
+	while ((s < end) && (*s != '\n')) s++;
+	return (s < end) ? s + 1 : s;
+}
+
+typedef struct TextChunk {
+	const char *begin;
+	const char *end;
+	DTfloat (*points)[2];	// points of the chunk, in order
+	DTsize n_points;
+	int64_t n_lines;		// number of lines parsed
+	int error;				// 1 if line n_lines of the chunk could not be parsed, 2 if there was not enough memory
+} TextChunk;
+
+/*
+ * Parses all the lines of a chunk of a text point file, until the first error.
+ *
+ * chunk:		the chunk, whose begin and end are at the start of a line (or the end of the text)
+ */
+static void parseTextChunk(TextChunk *chunk) {
+	size_t capacity = (size_t) (chunk->end - chunk->begin) / 12 + 16;
+	chunk->points = malloc(sizeof(chunk->points[0]) * capacity);
+	chunk->n_points = 0;
+	chunk->n_lines = 0;
+	chunk->error = (chunk->points == NULL) ? 2 : 0;
+	if (chunk->error) return;
+
+	const char *s = chunk->begin;
+	while (s < chunk->end) {
+		if ((size_t) chunk->n_points == capacity) {
+			DTfloat (*points)[2] = realloc(chunk->points, sizeof(chunk->points[0]) * 2 * capacity);
+			if (points == NULL) {
+				chunk->error = 2;
+				return;
+			}
+			chunk->points = points;
+			capacity *= 2;
+		}
+		int status;
+		s = parseTextLine(s, chunk->end, chunk->points[chunk->n_points], &status);
+		if (status == -1) {
+			chunk->error = 1;
+			return;
+		}
+		chunk->n_points += status;
+		chunk->n_lines++;
+	}
+}
+
+/*
+ * Parses a text point file, as written by fsaveDelaunayTriangulation or
+ * given with the -i option: a first line with the number of points n
+ * (anything after it on this line is ignored, e.g. the number of line points
+ * written by fsaveDelaunayTriangulation), followed by at least n lines of
+ * two numbers. Only the n first points are read.
+ *
+ * The file is cut into chunks at line boundaries that are parsed in
+ * parallel, without scanf. On error, the exact line is reported.
+ *
+ * The returned PointFile owns a copy of the points (its map is NULL), and
+ * must be closed with closePointFile.
+ *
+ * filename:	the name of the file
+ * n_threads:	the number of threads, 0 to use all available threads
+ *
+ * returns:		the PointFile, NULL if it could not be read
+ */
+PointFile* openTextPointFile(const char *filename, int n_threads) {
+	char *text = NULL;
+	size_t size = 0;
+
+#ifndef _WIN32
+	int fd = open(filename, O_RDONLY);
+	if (fd == -1) {
+		printf("ERROR: File %s not found\n", filename);
+		return NULL;
+	}
+	struct stat st;
+	if (fstat(fd, &st) == 0) size = (size_t) st.st_size;
+	if (size > 0) {
+		text = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (text == MAP_FAILED) text = NULL;
+		else madvise(text, size, MADV_SEQUENTIAL);
+	}
+	close(fd);
+#else
+	FILE *file_in = fopen(filename, "rb");
+	if (file_in == NULL) {
+		printf("ERROR: File %s not found\n", filename);
+		return NULL;
+	}
+	fseek(file_in, 0, SEEK_END);
+	size = (size_t) _ftelli64(file_in);
+	fseek(file_in, 0, SEEK_SET);
+	text = malloc(size + 1);
+	if ((text == NULL) || (fread(text, 1, size, file_in) != size)) size = 0;
+	fclose(file_in);
+#endif
+
+	const char *s = text, *end = text + size;
+	long long n = -1;
+
+	// First line: the number of points, then anything
+	while ((s < end) && ((*s == ' ') || (*s == '\t'))) s++;
+	if ((s < end) && ((unsigned) (*s - '0') < 10)) {
+		n = 0;
+		while ((s < end) && ((unsigned) (*s - '0') < 10) && (n <= 0x7fffffff)) {
+			n = 10 * n + (*s++ - '0');
+		}
+	}
+	if ((n < 0) || (n > 0x7fffffff)) {
+		printf("ERROR: First line doesn't match  %%d format\n");
+		n = -1;
+	}
+	while ((s < end) && (*s != '\n')) s++;
+	if (s < end) s++;
+
+#ifdef _OPENMP
+	if (n_threads <= 0) n_threads = omp_get_max_threads();
+#else
+	n_threads = 1;
+#endif
+	int n_chunks = 1;
+	if ((n >= 0) && (end - s > TEXT_CHUNK_MIN_SIZE)) {
+		n_chunks = (int) ((end - s) / TEXT_CHUNK_MIN_SIZE);
+		if (n_chunks > 4 * n_threads) n_chunks = 4 * n_threads;
+		if (n_chunks < 1) n_chunks = 1;
+	}
+
+	// Chunks of the same size, moved forward to the start of a line
+	TextChunk *chunks = calloc((size_t) n_chunks, sizeof(TextChunk));
+	if (chunks == NULL) {
+		printf("ERROR: Couldn't allocate memory to parse %s\n", filename);
+#ifndef _WIN32
+		if (text != NULL) munmap(text, size);
+#else
+		free(text);
+#endif
+		return NULL;
+	}
+	for (int c = 0; c < n_chunks; c++) {
+		const char *begin = s + (end - s) / n_chunks * c;
+		if (c > 0) {
+			begin = memchr(begin - 1, '\n', (size_t) (end - begin + 1));
+			begin = (begin == NULL) ? end : begin + 1;
+		}
+		chunks[c].begin = begin;
+		if (c > 0) chunks[c - 1].end = begin;
+	}
+	chunks[n_chunks - 1].end = end;
+
+	if (n >= 0) {
+		#pragma omp parallel for schedule(dynamic, 1) num_threads(n_threads) if(n_chunks > 1)
+		for (int c = 0; c < n_chunks; c++) {
+			parseTextChunk(&chunks[c]);
+		}
+	}
+
+	// Points before each chunk, errors after the n first points are ignored
+	PointFile *file = NULL;
+	int64_t line = 2;
+	DTsize total = 0;
+	for (int c = 0; (n >= 0) && (c < n_chunks) && (total < n); c++) {
+		if (chunks[c].error && (total + chunks[c].n_points < n)) {
+			if (chunks[c].error == 2) printf("ERROR: Couldn't allocate memory to parse %s\n", filename);
+			else printf("ERROR: Line %lld of %s could not be parsed as two numbers\n",
+						(long long) (line + chunks[c].n_lines), filename);
+			n = -1;
+			break;
+		}
+		line += chunks[c].n_lines;
+		total += chunks[c].n_points;
+	}
+	if ((n >= 0) && (total < n)) {
+		printf("ERROR: File %s has %d points instead of %lld\n", filename, total, n);
+		n = -1;
+	}
+
+	if (n >= 0) {
+		file = malloc(sizeof(PointFile));
+		if (file != NULL) {
+			file->points = malloc(sizeof(file->points[0]) * (n > 0 ? n : 1));
+			if (file->points == NULL) {
+				free(file);
+				file = NULL;
+			}
+		}
+		if (file == NULL) {
+			printf("ERROR: Couldn't allocate memory for the points of %s\n", filename);
+			n = -1;
+		}
+	}
+
+	if (n >= 0) {
+		memset(&file->header, 0, sizeof(PointFileHeader));
+		memcpy(file->header.magic, POINT_FILE_MAGIC, 8);
+		file->header.version = POINT_FILE_VERSION;
+		file->header.precision = sizeof(DTfloat);
+		file->header.n_points = (uint64_t) n;
+		file->n_points = (DTsize) n;
+		file->sorted = 0;
+		file->map = NULL;
+		file->map_size = 0;
+
+		DTsize offset = 0;
+		for (int c = 0; (c < n_chunks) && (offset < n); c++) {
+			DTsize count = (chunks[c].n_points < n - offset) ? chunks[c].n_points : (DTsize) (n - offset);
+			memcpy(file->points[offset], chunks[c].points, sizeof(file->points[0]) * count);
+			offset += count;
+		}
+
+		DTfloat bounds[2][2] = {{0.0, 0.0}, {0.0, 0.0}};
+		getPointsBoudingBox(file->points, file->n_points, bounds);
+		for (int i = 0; i < 2; i++) {
+			file->header.bounds[i][0] = bounds[i][0];
+			file->header.bounds[i][1] = bounds[i][1];
+		}
+	}
+
+	for (int c = 0; c < n_chunks; c++) {
+		free(chunks[c].points);
+	}
+	free(chunks);
+
+#ifndef _WIN32
+	if (text != NULL) munmap(text, size);
+#else
+	free(text);
+#endif
+	return file;
+}
+
+// End: text point files //
+
+// Begin: mesh files //
+
+typedef struct TextWriter {
+	FILE *file;
+	char *buffer;
+	size_t size;
+	int ok;
+} TextWriter;
+
+/*
+ * Writes the buffer of a TextWriter into its file, and empties it.
+ *
+ * writer:		the TextWriter
+ */
+static void flushTextWriter(TextWriter *writer) {
+	if (writer->size > 0) {
+		writer->ok &= (fwrite(writer->buffer, 1, writer->size, writer->file) == writer->size);
+	}
+	writer->size = 0;
+}
+
+/*
+ * Appends integers to the buffer of a TextWriter, separated by spaces and
+ * followed by a newline. The buffer is written when it is almost full.
+ *
+ * writer:		the TextWriter
+ * values:		the integers
+ * n:			the number of integers
+ */
+static void writeTextIntegers(TextWriter *writer, const DTsize values[], int n) {
+	if (writer->size + 12 * n + 1 > MESH_FILE_BUFFER_SIZE) flushTextWriter(writer);
+	char *s = writer->buffer + writer->size;
+	for (int k = 0; k < n; k++) {
+		long long v = values[k];
+		if (v < 0) {
+			*s++ = '-';
+			v = -v;
+		}
+		char digits[20];
+		int n_digits = 0;
+		do {
+			digits[n_digits++] = (char) ('0' + v % 10);
+			v /= 10;
+		} while (v > 0);
+		while (n_digits > 0) *s++ = digits[--n_digits];
+		*s++ = (k == n - 1) ? '\n' : ' ';
+	}
+	writer->size = (size_t) (s - writer->buffer);
+}
+
+/*
+ * Appends a point to the buffer of a TextWriter, with enough digits to be
+ * read back exactly.
+ *
+ * writer:		the TextWriter
+ * point:		the point
+ */
+static void writeTextPoint(TextWriter *writer, const DTfloat point[2]) {
+	if (writer->size + 64 > MESH_FILE_BUFFER_SIZE) flushTextWriter(writer);
+	int n = snprintf(writer->buffer + writer->size, 64, (sizeof(DTfloat) == 4) ? "%.9g %.9g\n" : "%.17g %.17g\n",
+					 (double) point[0], (double) point[1]);
+	writer->size += (size_t) n;
+}
+
+/*
+ * Saves the triangulation of a DelaunayTriangulation as a mesh file (see
+ * pointfile.h): the points once, followed by the triangles as triples of
+ * point indices and, optionally, by the neighbors of the triangles. Unlike
+ * fsaveDelaunayTriangulation, the connectivity is kept and every point is
+ * written once.
+ *
+ * filename:		the name of the file
+ * delTri:			the DelaunayTriangulation structure, triangulated
+ * binary:			if set, the file is a binary mesh file, otherwise a text one
+ * with_neighbors:	if set, the neighbors of the triangles are also written
+ *
+ * returns:			1 if the file was written, 0 otherwise
+ */
+int saveMeshFile(const char *filename, DelaunayTriangulation *delTri, int binary, int with_neighbors) {
+	if (!delTri->success) {
+		printf("ERROR: Mesh file %s needs a triangulation\n", filename);
+		return 0;
+	}
+
+	// Deleted points are not written
+	DTsize n_points = getDelaunayTriangulationNumberOfPoints(delTri);
+	DTfloat (*points)[2] = delTri->points;
+	if (n_points != delTri->n_points) {
+		points = malloc(sizeof(points[0]) * MAX(n_points, 1));
+		if (points != NULL) getDelaunayTriangulationPoints(delTri, points);
+	}
+
+	DTsize n_triangles = getNumberOfTriangles(delTri);
+	DTsize (*triangles)[3] = malloc(sizeof(triangles[0]) * MAX(n_triangles, 1));
+	DTsize (*neighbors)[3] = with_neighbors ? malloc(sizeof(neighbors[0]) * MAX(n_triangles, 1)) : NULL;
+	char *buffer = binary ? NULL : malloc(MESH_FILE_BUFFER_SIZE);
+	int ok = (points != NULL) && (triangles != NULL) && ((!with_neighbors) || (neighbors != NULL)) && (binary || (buffer != NULL));
+	if (!ok) {
+		printf("ERROR: Couldn't allocate memory for mesh file %s\n", filename);
+	}
+	else {
+		ok = (getDelaunayTriangulationTriangles(delTri, triangles, neighbors) == n_triangles);
+	}
+
+	FILE *file_out = NULL;
+	if (ok) {
+		file_out = fopen(filename, binary ? "wb" : "w");
+		ok = (file_out != NULL);
+		if (!ok) printf("ERROR: Couldn't open file %s in write mode.\n", filename);
+	}
+
+	if (ok && binary) {
+		PointFileHeader header;
+		memset(&header, 0, sizeof(header));
+		memcpy(header.magic, POINT_FILE_MAGIC, 8);
+		header.version = POINT_FILE_VERSION;
+		header.precision = sizeof(DTfloat);
+		header.n_points = (uint64_t) n_points;
+		header.flags = POINT_FILE_TRIANGLES | (delTri->sorted ? POINT_FILE_SORTED : 0) | (with_neighbors ? POINT_FILE_NEIGHBORS : 0);
+
+		DTfloat bounds[2][2] = {{0.0, 0.0}, {0.0, 0.0}};
+		getPointsBoudingBox(points, n_points, bounds);
+		for (int i = 0; i < 2; i++) {
+			header.bounds[i][0] = bounds[i][0];
+			header.bounds[i][1] = bounds[i][1];
+		}
+
+		uint64_t count = (uint64_t) n_triangles;
+		ok = (fwrite(&header, sizeof(header), 1, file_out) == 1) &&
+			 (fwrite(points, sizeof(points[0]), n_points, file_out) == (size_t) n_points) &&
+			 (fwrite(&count, sizeof(count), 1, file_out) == 1) &&
+			 (fwrite(triangles, sizeof(triangles[0]), n_triangles, file_out) == (size_t) n_triangles) &&
+			 ((!with_neighbors) || (fwrite(neighbors, sizeof(neighbors[0]), n_triangles, file_out) == (size_t) n_triangles));
+	}
+	else if (ok) {
+		TextWriter writer = {file_out, buffer, 0, 1};
+		DTsize counts[3] = {n_points, n_triangles, with_neighbors ? 1 : 0};
+		writeTextIntegers(&writer, counts, 3);
+		for (DTsize i = 0; i < n_points; i++) {
+			writeTextPoint(&writer, points[i]);
+		}
+		for (DTsize t = 0; t < n_triangles; t++) {
+			writeTextIntegers(&writer, triangles[t], 3);
+		}
+		for (DTsize t = 0; with_neighbors && (t < n_triangles); t++) {
+			writeTextIntegers(&writer, neighbors[t], 3);
+		}
+		flushTextWriter(&writer);
+		ok = writer.ok;
+	}
+
+	if (file_out != NULL) {
+		if (!ok) printf("ERROR: Couldn't write mesh to file %s\n", filename);
+		fclose(file_out);
+	}
+
+	if (points != delTri->points) free(points);
+	free(triangles);
+	if (neighbors != NULL) free(neighbors);
+	free(buffer);
+	return ok;
+}
+
+// End: mesh files //
@@ -0,0 +1,91 @@
+/*
+ * Binary point files of the Delaunay triangulation program, read with mmap.
+ *
+ * Author: 	Jerome Eertmans
+ * Context: project for the LMECA2710 course, at EPL faculty UCLouvain,
+ *			given by Pr. Vincent Legat and Pr. Jean-Francois Remacle.
+ *
+ * All sources of inspiration are clearly marked at specific places in the code.
+ * Feel free to use and re-use this code! No attribution but the ones for BOV.h,
+ * predicates.h and the sound files are required.
+ *
+ * Any contribution is welcome on the Github this project:
+ * https://github.com/jeertmans/DelaunayTriangulation
+ */
+
+#ifndef _POINTFILE_H
+#define _POINTFILE_H
+
+#include "delaunay.h"
+
+/*
+ * Format of a point file (all values are little-endian):
+ *
+ * offset	size	content
+ * 0		8		magic, the characters "DTPOINTS"
+ * 8		4		version (uint32), POINT_FILE_VERSION
+ * 12		4		precision (uint32), bytes per coordinate: 4 (float) or 8 (double)
+ * 16		8		number of points (uint64)
+ * 24		4		flags (uint32), POINT_FILE_SORTED if the points are sorted as sortPoints does
+ * 28		4		reserved, 0
+ * 32		32		bounding box (4 doubles): x_min, y_min, x_max, y_max
+ * 64		...		the points, x then y, with the given precision
+ *
+ * The points start at offset 64, so they are aligned when the file is mapped.
+ *
+ * A mesh file (see saveMeshFile) is a point file with the POINT_FILE_TRIANGLES
+ * flag, where the points are followed by:
+ *
+ * size		content
+ * 8		number of triangles n_triangles (uint64)
+ * 12 * n	the triangles, as counterclockwise triples of point indices (int32)
+ * 12 * n	if POINT_FILE_NEIGHBORS is set, the neighbors of each triangle (int32),
+ *			neighbor k being on the other side of the edge from point k to point
+ *			(k + 1) % 3, -1 on the convex hull
+ *
+ * so it can also be read as a point file. The text version of a mesh file is:
+ *
+ * n_points n_triangles with_neighbors	(first line)
+ * x y			n_points lines, the points
+ * a b c		n_triangles lines, the triangles
+ * na nb nc		n_triangles lines if with_neighbors is 1, the neighbors
+ *
+ * which can also be read as a text point file (see openTextPointFile).
+ */
+
+#define POINT_FILE_MAGIC "DTPOINTS"
+#define POINT_FILE_VERSION 1
+#define POINT_FILE_SORTED 1		// Flag set if the points are sorted (x, then y)
+#define POINT_FILE_TRIANGLES 2	// Flag set if the points are followed by triangles (mesh file)
+#define POINT_FILE_NEIGHBORS 4	// Flag set if the triangles are followed by their neighbors
+
+#define MESH_FILE_BUFFER_SIZE (1 << 20)	// Size of the buffer in which text mesh files are formatted
+
+typedef struct PointFileHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t precision;
+	uint64_t n_points;
+	uint32_t flags;
+	uint32_t reserved;
+	double bounds[2][2];
+} PointFileHeader;
+
+typedef struct PointFile {
+	PointFileHeader header;
+	DTsize n_points;
+	int sorted;				// 1 if the points are sorted (x, then y)
+	DTfloat (*points)[2];	// mapped points, or a copy if the precision of the file differs from DTfloat's
+
+	void *map;				// mapping of the whole file, NULL if the points were read into memory
+	size_t map_size;
+} PointFile;
+
+int isPointFile(const char *filename);
+PointFile* openPointFile(const char *filename);
+void closePointFile(PointFile *file);
+int savePointFile(const char *filename, DTfloat points[][2], DTsize n_points, int sorted);
+PointFile* openTextPointFile(const char *filename, int n_threads);
+int saveMeshFile(const char *filename, DelaunayTriangulation *delTri, int binary, int with_neighbors);
+
+#endif
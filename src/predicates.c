@@ -36,8 +36,9 @@
 /*  First, read the short or long version of the paper (from the Web page    */
 /*    above).                                                                */
 /*                                                                           */
-/*  Be sure to call exactinit() once, before calling any of the arithmetic   */
-/*    functions or geometric predicates.  Also be sure to turn on the        */
+/*  The constants used for exact arithmetic are fixed at compile time (see   */
+/*    `splitter' and PREDICATE_EPSILON below), so no initialization is       */
+/*    needed and the predicates are reentrant.  Be sure to turn on the       */
 /*    optimizer when compiling this file.                                    */
 /*                                                                           */
 /*                                                                           */
@@ -113,7 +114,7 @@
 /*                                                                           */
 /*****************************************************************************/
 
-//#include "predicates.h"
+#include "predicates.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -133,7 +134,7 @@
 /* #define INEXACT volatile */
 
 //typedef double REAL;
-#define REAL float                      /* float or double */
+#define REAL DTfloat                    /* float or double, see predicates.h */
 #define REALPRINT doubleprint
 #define REALRAND doublerand
 #define NARROWRAND narrowdoublerand
@@ -361,14 +362,42 @@
   Square(a1, _j, _1); \
   Two_Two_Sum(_j, _1, _l, _2, x5, x4, x3, x2)
 
-REAL splitter;     /* = 2^ceiling(p / 2) + 1.  Used to split floats in half. */
-REAL epsilon;                /* = 2^(-p).  Used to estimate roundoff errors. */
+/* PREDICATE_EPSILON (epsilon) is the largest power of two such that         */
+/*   1.0 + epsilon = 1.0 in REAL arithmetic, and bounds the relative         */
+/*   roundoff error.  `splitter' is used to split REALs into two half-length */
+/*   significands for exact multiplication.  Both only depend on the         */
+/*   precision p of REAL, so they are fixed at compile time rather than      */
+/*   probed at run time: the constants below are never written, and the      */
+/*   predicates can be called concurrently from any number of threads        */
+/*   without initialization.                                                 */
+
+#if DOUBLE_PRECISION
+#define PREDICATE_EPSILON 1.1102230246251565404e-16     /* 2^-53, p = 53 */
+#define PREDICATE_SPLITTER 134217729.0                  /* 2^27 + 1 */
+#else
+#define PREDICATE_EPSILON 5.9604644775390625e-08        /* 2^-24, p = 24 */
+#define PREDICATE_SPLITTER 4097.0                       /* 2^12 + 1 */
+#endif
+
+static const REAL splitter = PREDICATE_SPLITTER;   /* = 2^ceiling(p / 2) + 1. */
 /* A set of coefficients used to calculate maximum roundoff errors.          */
-REAL resulterrbound;
-REAL ccwerrboundA, ccwerrboundB, ccwerrboundC;
-REAL o3derrboundA, o3derrboundB, o3derrboundC;
-REAL iccerrboundA, iccerrboundB, iccerrboundC;
-REAL isperrboundA, isperrboundB, isperrboundC;
+static const REAL resulterrbound = (3.0 + 8.0 * PREDICATE_EPSILON) * PREDICATE_EPSILON;
+static const REAL ccwerrboundA = (3.0 + 16.0 * PREDICATE_EPSILON) * PREDICATE_EPSILON;
+static const REAL ccwerrboundB = (2.0 + 12.0 * PREDICATE_EPSILON) * PREDICATE_EPSILON;
+static const REAL ccwerrboundC = (9.0 + 64.0 * PREDICATE_EPSILON) * PREDICATE_EPSILON * PREDICATE_EPSILON;
+static const REAL o3derrboundA = (7.0 + 56.0 * PREDICATE_EPSILON) * PREDICATE_EPSILON;
+static const REAL o3derrboundB = (3.0 + 28.0 * PREDICATE_EPSILON) * PREDICATE_EPSILON;
+static const REAL o3derrboundC = (26.0 + 288.0 * PREDICATE_EPSILON) * PREDICATE_EPSILON * PREDICATE_EPSILON;
+static const REAL iccerrboundA = (10.0 + 96.0 * PREDICATE_EPSILON) * PREDICATE_EPSILON;
+static const REAL iccerrboundB = (4.0 + 48.0 * PREDICATE_EPSILON) * PREDICATE_EPSILON;
+static const REAL iccerrboundC = (44.0 + 576.0 * PREDICATE_EPSILON) * PREDICATE_EPSILON * PREDICATE_EPSILON;
+static const REAL isperrboundA = (16.0 + 224.0 * PREDICATE_EPSILON) * PREDICATE_EPSILON;
+static const REAL isperrboundB = (5.0 + 72.0 * PREDICATE_EPSILON) * PREDICATE_EPSILON;
+static const REAL isperrboundC = (71.0 + 1408.0 * PREDICATE_EPSILON) * PREDICATE_EPSILON * PREDICATE_EPSILON;
+
+/* Number of calls decided at each stage, see predicates.h.                  */
+unsigned long orient2d_stats[PREDICATE_STAGES];
+unsigned long incircle_stats[PREDICATE_STAGES];
 
 /*****************************************************************************/
 /*                                                                           */
@@ -624,67 +653,6 @@ float uniformfloatrand()
   return result;
 }
 
-/*****************************************************************************/
-/*                                                                           */
-/*  exactinit()   Initialize the variables used for exact arithmetic.        */
-/*                                                                           */
-/*  `epsilon' is the largest power of two such that 1.0 + epsilon = 1.0 in   */
-/*  floating-point arithmetic.  `epsilon' bounds the relative roundoff       */
-/*  error.  It is used for floating-point error analysis.                    */
-/*                                                                           */
-/*  `splitter' is used to split floating-point numbers into two half-        */
-/*  length significands for exact multiplication.                            */
-/*                                                                           */
-/*  I imagine that a highly optimizing compiler might be too smart for its   */
-/*  own good, and somehow cause this routine to fail, if it pretends that    */
-/*  floating-point arithmetic is too much like real arithmetic.              */
-/*                                                                           */
-/*  Don't change this routine unless you fully understand it.                */
-/*                                                                           */
-/*****************************************************************************/
-
-void exactinit()
-{
-  REAL half;
-  REAL check, lastcheck;
-  int every_other;
-
-  every_other = 1;
-  half = 0.5;
-  epsilon = 1.0;
-  splitter = 1.0;
-  check = 1.0;
-  /* Repeatedly divide `epsilon' by two until it is too small to add to    */
-  /*   one without causing roundoff.  (Also check if the sum is equal to   */
-  /*   the previous sum, for machines that round up instead of using exact */
-  /*   rounding.  Not that this library will work on such machines anyway. */
-  do {
-    lastcheck = check;
-    epsilon *= half;
-    if (every_other) {
-      splitter *= 2.0;
-    }
-    every_other = !every_other;
-    check = 1.0 + epsilon;
-  } while ((check != 1.0) && (check != lastcheck));
-  splitter += 1.0;
-
-  /* Error bounds for orientation and incircle tests. */
-  resulterrbound = (3.0 + 8.0 * epsilon) * epsilon;
-  ccwerrboundA = (3.0 + 16.0 * epsilon) * epsilon;
-  ccwerrboundB = (2.0 + 12.0 * epsilon) * epsilon;
-  ccwerrboundC = (9.0 + 64.0 * epsilon) * epsilon * epsilon;
-  o3derrboundA = (7.0 + 56.0 * epsilon) * epsilon;
-  o3derrboundB = (3.0 + 28.0 * epsilon) * epsilon;
-  o3derrboundC = (26.0 + 288.0 * epsilon) * epsilon * epsilon;
-  iccerrboundA = (10.0 + 96.0 * epsilon) * epsilon;
-  iccerrboundB = (4.0 + 48.0 * epsilon) * epsilon;
-  iccerrboundC = (44.0 + 576.0 * epsilon) * epsilon * epsilon;
-  isperrboundA = (16.0 + 224.0 * epsilon) * epsilon;
-  isperrboundB = (5.0 + 72.0 * epsilon) * epsilon;
-  isperrboundC = (71.0 + 1408.0 * epsilon) * epsilon * epsilon;
-}
-
 /*****************************************************************************/
 /*                                                                           */
 /*  grow_expansion()   Add a scalar to an expansion.                         */
@@ -1598,6 +1566,8 @@ REAL detsum;
     return det;
   }
 
+  COUNT_PREDICATE(orient2d_stats, PREDICATE_EXACT);
+
   Two_Product(acxtail, bcy, s1, s0);
   Two_Product(acytail, bcx, t1, t0);
   Two_Two_Diff(s1, s0, t1, t0, u3, u[2], u[1], u[0]);
@@ -2790,6 +2760,8 @@ REAL permanent;
     return det;
   }
 
+  COUNT_PREDICATE(incircle_stats, PREDICATE_EXACT);
+
   finnow = fin1;
   finother = fin2;
 
@@ -7,8 +7,36 @@
 #include <math.h>
 #include <sys/time.h>
 
-void exactinit();
-float incircle(float *pa, float *pb, float *pc, float *pd);
-float orient2d(float *pa, float *pb, float *pc);
+#ifndef DOUBLE_PRECISION
+#define DOUBLE_PRECISION 0	// If True, coordinates are stored and predicates computed as doubles instead of floats
+#endif
+
+#if DOUBLE_PRECISION
+typedef double DTfloat;
+#else
+typedef float DTfloat;
+#endif
+
+#ifndef PREDICATE_STATS
+#define PREDICATE_STATS 0	// If True, counts the stage deciding each predicate (slows down parallel triangulations)
+#endif
+
+// Stages of a robust predicate
+#define PREDICATE_FILTER 0		// decided by the floating-point filter (in delaunay.c)
+#define PREDICATE_ADAPTIVE 1	// passed to the adaptive routines of predicates.c
+#define PREDICATE_EXACT 2		// among those, needed the exact expansion of the determinant
+#define PREDICATE_STAGES 3
+
+#if PREDICATE_STATS
+#define COUNT_PREDICATE(stats, stage) do { _Pragma("omp atomic") (stats)[stage]++; } while (0)
+#else
+#define COUNT_PREDICATE(stats, stage) do { } while (0)
+#endif
+
+extern unsigned long orient2d_stats[PREDICATE_STAGES];
+extern unsigned long incircle_stats[PREDICATE_STAGES];
+
+DTfloat incircle(DTfloat *pa, DTfloat *pb, DTfloat *pc, DTfloat *pd);
+DTfloat orient2d(DTfloat *pa, DTfloat *pb, DTfloat *pc);
 
 #endif
@@ -0,0 +1,983 @@
+/*
+ * Viewer of the Delaunay triangulation program, drawn with BOV.
+ *
+ * Author: 	Jerome Eertmans
+ * Context: project for the LMECA2710 course, at EPL faculty UCLouvain,
+ *			given by Pr. Vincent Legat and Pr. Jean-Francois Remacle.
+ *
+ * All sources of inspiration are clearly marked at specific places in the code.
+ * Feel free to use and re-use this code! No attribution but the ones for BOV.h,
+ * predicates.h and the sound files are required.
+ *
+ * Any contribution is welcome on the Github this project:
+ * https://github.com/jeertmans/DelaunayTriangulation
+ */
+
+#include "viewer.h"
+
+//////////////////////////////
+// Begin: Drawing functions //
+//////////////////////////////
+
+/*
+ * Creates or updates the drawing of the points of the DelaunayTriangulation,
+ * without the deleted points. The points are converted to GLfloat if needed.
+ *
+ * delTri:		the DelaunayTriangulation structure
+ * pointsDraw:	the drawing to update, NULL to create a new one
+ *
+ * returns:		the drawing of the points
+ */
+bov_points_t* updatePointsDraw(DelaunayTriangulation *delTri, bov_points_t *pointsDraw) {
+	GLsizei n_points = getDelaunayTriangulationNumberOfPoints(delTri);
+
+#if !DOUBLE_PRECISION
+	if (delTri->n_free_points == 0) {
+		if (pointsDraw == NULL) return bov_points_new(delTri->points, n_points, GL_STATIC_DRAW);
+		return bov_points_update(pointsDraw, delTri->points, n_points);
+	}
+#endif
+
+	GLfloat (*points)[2] = malloc(sizeof(points[0]) * n_points);
+	GLsizei c = 0;
+	for (GLsizei i = 0; i < delTri->n_points; i++) {
+		if (!POINT_DELETED(delTri, i)) {
+			points[c][0] = delTri->points[i][0];
+			points[c][1] = delTri->points[i][1];
+			c++;
+		}
+	}
+
+	if (pointsDraw == NULL) {
+		pointsDraw = bov_points_new(points, n_points, GL_STATIC_DRAW);
+	}
+	else {
+		bov_points_update(pointsDraw, points, n_points);
+	}
+	free(points);
+	return pointsDraw;
+}
+
+/*
+ * Returns the position of the mouse in the x, y coordinates.
+ *
+ * window:		the window
+ * mouse_pos:	the preallocated array that will contain the position
+ */
+void getMousePosition(bov_window_t *window, GLfloat mouse_pos[2]) {
+	mouse_pos[0] = (window->cursorPos[0] - window->param.translate[0]);
+	mouse_pos[1] = (window->cursorPos[1] - window->param.translate[1]);
+}
+
+/*
+ * Fills the information text with some data.
+ *
+ * delTri:			the DelaunayTriangulation structure
+ * info_text_char:	the preallocated array that will contain the text
+ */
+void getInfoText(DelaunayTriangulation *delTri, char *info_text_char) {
+	sprintf(info_text_char, "Number of points: %7d / Smallest angle : %2.2f\xba", getDelaunayTriangulationNumberOfPoints(delTri), RAD2DEG(getSmallestAngle(delTri)));
+}
+
+/*
+ * Provides quite a few tools to visualize the DelaunayTriangulation.
+ *
+ * delTri:		the DelaunayTriangulation structure
+ * window:		the window
+ * total_time:	the total time the animation should approximatively last
+ */
+void drawDelaunayTriangulation(DelaunayTriangulation *delTri, bov_window_t *window, double total_time) {
+	// Information text
+	bov_text_t* text = bov_text_new(
+		(GLubyte[]) {"This plot is interactive!\n"
+		             "\xf8 Press [A/D] to add/delete a point nearby your cursor\n"
+					 "\xee Hold [SHIFT] while pressing [A/D] to repeat\n"
+					 "\xf8 Hold  [S]   to select a point nearby your cursor and\n"
+					 "              change its location\n"
+					 "\xf8 Press [O]   to show/hide points\n"
+					 "\xf8 Press [L]   to show/hide triangulation lines\n"
+					 "\xf8 Press [V]   to show/hide Voronoi diagram\n"
+		             "\xf8 Press [F]   to switch between fast and pretty drawing\n"
+					 "\xf8 Press [I]   to illustrate each step of the triangulation\n"
+					 "\xf8 Press [G]   to show/hide the SMallest Angle Game rules\n"
+				     "\xf8 Press [X]   to show/hide this text\n"
+				     "\xf8 Press [H]   to show/hide the default help menu\n\n"
+				 	 "\x8a Features using DRAG & DROP may not work correctly\n"
+					 "with a trackpad: please use a mouse."},
+		GL_STATIC_DRAW);
+	bov_text_set_space_type(text, PIXEL_SPACE);
+	bov_text_param_t text_parameters = bov_text_get_param(text);
+	text_parameters.fontSize *= .7;
+	bov_text_set_param(text, text_parameters);
+
+	GLubyte info_text_char[200] = {""};
+
+	getInfoText(delTri, info_text_char);
+
+	bov_text_t* info_text = bov_text_new(info_text_char, GL_STATIC_DRAW);
+	bov_text_set_space_type(info_text, PIXEL_SPACE);
+
+	// Game rules
+	bov_text_t* rules = bov_text_new(
+		(GLubyte[]) {"\t\t\t\t\tPlay the SMallest Angle Game (SMAG) !\n"
+		 			 "\n"
+					 "Delaunay triangulation is used because it maximises the smallest angle.\n"
+					 "\n"
+					 "Here are the rules:\n"
+					 "\n"
+		             "\t1. Choose a minimum angle you should never be lower than (eg.: 5\xba)\n"
+		             "\t2. Delete all the points or restart with -n 0 flag\n"
+					 "\t3. Try to add new points while staying above the minimum angle\n"
+					 "\t4. When you break the limit, the game is over!\n"
+					 "\t   Record the # of points you reached and challenge you friends to do better\n"
+					 "\n"
+					 "Alternatively, you can play with friends on the same computer, and\n"
+					 "the one who first breaks the limit loses the game."},
+		GL_STATIC_DRAW);
+	bov_text_set_space_type(rules, PIXEL_SPACE);
+	bov_text_param_t rules_parameters = bov_text_get_param(rules);
+	rules_parameters.fontSize *= .7;
+	bov_text_set_param(rules, rules_parameters);
+
+	// Points
+    bov_points_t *pointsDraw = updatePointsDraw(delTri, NULL);
+	bov_points_set_color(pointsDraw, BASIC_POINTS_COLOR);
+	bov_points_set_outline_color(pointsDraw, BASIC_POINTS_OUTLINE_COLOR);
+	bov_points_set_width(pointsDraw, BASIC_POINTS_WIDTH);
+
+	DTfloat bounds[][2] = {{0.0, 0.0}, {0.0, 0.0}};
+
+	// Lines (edges)
+	GLsizei n_lines = 0;
+	GLfloat (*linesPoints)[2] = NULL;
+	bov_points_t *linesDraw = bov_points_new(linesPoints, n_lines, GL_STATIC_DRAW);
+	bov_points_set_color(linesDraw, TRIANGULATION_LINES_COLOR);
+	bov_points_set_width(linesDraw, TRIANGULATION_LINES_WIDTH);
+	bov_points_set_outline_color(linesDraw, TRIANGULATION_LINES_OUTLINE_COLOR);
+	bov_points_set_outline_width(linesDraw, 0.5 * TRIANGULATION_LINES_WIDTH);
+
+	// If DelaunayTriangulation was computed, will display it
+	if (delTri->success) {
+		n_lines = getDelaunayTriangulationNumberOfLines(delTri);
+		linesPoints = malloc(sizeof(linesPoints[0]) * 2 * n_lines);
+		getDelaunayTriangulationLines(delTri, linesPoints, n_lines);
+		bov_points_update(linesDraw, linesPoints, 2 * n_lines);
+	}
+
+	// Some key bindings
+	// WARNING: here, I suppose you have an AZERTY layout
+	int FAST = (delTri->n_points > 100);
+	int VORONOI = 0;
+	int REQUIRE_UPDATE = 0;
+	int HIDE_TEXT = 0;
+	int SHOW_POINTS = 1;
+	int SHOW_LINES = 1;
+	int SHOW_GAME_RULES = 0;
+	int ILLUSTRATE = 0;
+	int KEY_A, KEY_D, KEY_S, KEY_F, KEY_V, KEY_X, KEY_O, KEY_L, KEY_I, KEY_G;
+	int KEY_SHIFT;
+	int LAST_KEY_A, LAST_KEY_D, LAST_KEY_F, LAST_KEY_V, LAST_KEY_X, LAST_KEY_O, LAST_KEY_L, LAST_KEY_I, LAST_KEY_G;
+	LAST_KEY_A = LAST_KEY_D = LAST_KEY_F = LAST_KEY_V = LAST_KEY_X = LAST_KEY_O = LAST_KEY_L = LAST_KEY_I = LAST_KEY_G = 0;
+
+	int idx = -1;
+
+	// Mouse
+	GLfloat mousePoint[][2] = {{0.0, 0.0}};
+	DTfloat mouseCoords[2];
+	bov_points_t *mouseDraw = bov_points_new(mousePoint, 1, GL_STATIC_DRAW);
+	bov_points_set_color(mouseDraw, MOUSE_POINTS_COLOR);
+	bov_points_set_outline_color(mouseDraw, MOUSE_POINTS_OUTLINE_COLOR);
+	bov_points_set_width(mouseDraw, MOUSE_POINTS_WIDTH);
+	bov_points_set_outline_width(mouseDraw, -.1);
+
+	// Voronoi
+	GLsizei n_triangles = 0;
+	GLfloat (*voronoiCenters)[2] = NULL;
+	bov_points_t *voronoiCentersDraw = bov_points_new(voronoiCenters, n_triangles, GL_STATIC_DRAW);
+	bov_points_set_color(voronoiCentersDraw, VORONOI_POINTS_COLOR);
+	bov_points_set_outline_color(voronoiCentersDraw, VORONOI_POINTS_OUTLINE_COLOR);
+	bov_points_set_width(voronoiCentersDraw, VORONOI_POINTS_WIDTH);
+
+	GLsizei n_voronoi_lines = 0;
+	GLsizei (*voronoiNeighbors)[3] = NULL;
+	GLfloat (*voronoiLines)[2] = NULL;
+	bov_points_t *voronoiLinesDraw = bov_points_new(linesPoints, n_lines, GL_STATIC_DRAW);
+	bov_points_set_color(voronoiLinesDraw, VORONOI_LINES_COLOR);
+	bov_points_set_width(voronoiLinesDraw, VORONOI_LINES_WIDTH);
+	bov_points_set_outline_color(voronoiLinesDraw, VORONOI_LINES_OUTLINE_COLOR);
+	bov_points_set_outline_width(voronoiLinesDraw, .5 * VORONOI_LINES_WIDTH);
+
+	// Write keystrokes in a file
+
+	FILE *file_out = fopen("data/.keys.txt", "w");
+	if (file_out == NULL) {
+		printf("Warning: could not open file data/.keys.txt.\n"
+			   "Make sure to run this program from the project directory to enable keystrokes saving.\n");
+	}
+
+	// Animation parameters
+	DTDrawingParameters *DTDparams;
+
+
+	while(!bov_window_should_close(window)){
+		// 1. Handle key bindings
+		getMousePosition(window, mousePoint[0]);
+		mouseCoords[0] = mousePoint[0][0];
+		mouseCoords[1] = mousePoint[0][1];
+		KEY_A = glfwGetKey(window->self, GLFW_KEY_Q); // QWERTY -> AZERTY layout
+		KEY_D = glfwGetKey(window->self, GLFW_KEY_D);
+		KEY_S = glfwGetKey(window->self, GLFW_KEY_S);
+		KEY_F = glfwGetKey(window->self, GLFW_KEY_F);
+		KEY_V = glfwGetKey(window->self, GLFW_KEY_V);
+		KEY_X = glfwGetKey(window->self, GLFW_KEY_X);
+		KEY_O = glfwGetKey(window->self, GLFW_KEY_O);
+		KEY_L = glfwGetKey(window->self, GLFW_KEY_L);
+		KEY_I = glfwGetKey(window->self, GLFW_KEY_I);
+		KEY_G = glfwGetKey(window->self, GLFW_KEY_G);
+		KEY_SHIFT = glfwGetKey(window->self, GLFW_KEY_LEFT_SHIFT) || glfwGetKey(window->self, GLFW_KEY_RIGHT_SHIFT);
+
+		if (KEY_A) {
+			if ((!LAST_KEY_A) || KEY_SHIFT) {
+				REQUIRE_UPDATE = addPoint(delTri, mouseCoords);
+				LAST_KEY_A = KEY_A;
+				if (file_out != NULL) {
+					fprintf(file_out, "A\n");
+					fflush(file_out);
+				}
+			}
+		}
+		else {
+			LAST_KEY_A = KEY_A;
+		}
+		if (KEY_D) {
+			if ((!LAST_KEY_D) || KEY_SHIFT) {
+				REQUIRE_UPDATE = deletePoint(delTri, mouseCoords);
+				LAST_KEY_D = KEY_D;
+				if (file_out != NULL) {
+					fprintf(file_out, "D\n");
+					fflush(file_out);
+				}
+			}
+		}
+		else {
+			LAST_KEY_D = KEY_D;
+		}
+		if (KEY_S) {
+			idx = getPointIndex(delTri, mouseCoords);
+			updatePointAtIndex(delTri, idx, mouseCoords);
+			REQUIRE_UPDATE = 1;
+			if (file_out != NULL) {
+				fprintf(file_out, "S\n");
+				fflush(file_out);
+			}
+		}
+		else {
+			idx = -1;
+		}
+		if (KEY_F) {
+			if (!LAST_KEY_F) {
+				FAST = !FAST;
+				LAST_KEY_F = KEY_F;
+				if (file_out != NULL) {
+					fprintf(file_out, "F\n");
+					fflush(file_out);
+				}
+			}
+		}
+		else {
+			LAST_KEY_F = KEY_F;
+		}
+		if (KEY_V) {
+			if (!LAST_KEY_V) {
+				VORONOI = !VORONOI;
+				LAST_KEY_V = KEY_V;
+				REQUIRE_UPDATE = 1;
+				if (file_out != NULL) {
+					fprintf(file_out, "V\n");
+					fflush(file_out);
+				}
+			}
+		}
+		else {
+			LAST_KEY_V = KEY_V;
+		}
+		if (KEY_X) {
+			if (!LAST_KEY_X) {
+				HIDE_TEXT = !HIDE_TEXT;
+				LAST_KEY_X = KEY_X;
+			}
+		}
+		else {
+			LAST_KEY_X = KEY_X;
+		}
+		if (KEY_O) {
+			if (!LAST_KEY_O) {
+				SHOW_POINTS = !SHOW_POINTS;
+				LAST_KEY_O = KEY_O;
+			}
+		}
+		else {
+			LAST_KEY_O = KEY_O;
+		}
+		if (KEY_L) {
+			if (!LAST_KEY_L) {
+				SHOW_LINES = !SHOW_LINES;
+				LAST_KEY_L = KEY_L;
+			}
+		}
+		else {
+			LAST_KEY_L = KEY_L;
+		}
+		if (KEY_I) {
+			if (!LAST_KEY_I) {
+				LAST_KEY_I = KEY_I;
+				ILLUSTRATE = 1;
+			}
+		}
+		else {
+			LAST_KEY_I = KEY_I;
+		}
+		if (KEY_G) {
+			if (!LAST_KEY_G) {
+				SHOW_GAME_RULES = !SHOW_GAME_RULES;
+				LAST_KEY_G = KEY_G;
+			}
+		}
+		else {
+			LAST_KEY_G = KEY_G;
+		}
+
+		if (SHOW_GAME_RULES) {
+			rules_parameters.pos[0] = bov_window_get_xres(window) / 2 - 400;
+			rules_parameters.pos[1] = bov_window_get_yres(window) / 2 + 150;
+			bov_text_set_param(rules, rules_parameters);
+
+			bov_text_draw(window, rules);
+			bov_window_update(window);
+			continue;
+		}
+
+		// 0. We required illustration mode
+
+		else if (ILLUSTRATE) {
+			resetDelaunayTriangulation(delTri);
+			compactPoints(delTri);
+
+			getPointsBoudingBox(delTri->points, delTri->n_points, bounds);
+
+			// Active points
+		    bov_points_t *activePointsDraw = updatePointsDraw(delTri, NULL);
+			bov_points_set_color(activePointsDraw, ACTIVE_POINTS_COLOR);
+			bov_points_set_outline_color(activePointsDraw, ACTIVE_POINTS_OUTLINE_COLOR);
+			bov_points_set_width(activePointsDraw, ACTIVE_POINTS_WIDTH);
+
+			// Trying to make the sleep time % to the inverse of the number of edges
+			// (roughly 3 * n * log(n) edges are created by the divide and conquer)
+
+			int sleep = (int) (total_time / MAX(ceil(log(delTri->n_points) * 3 * delTri->n_points), 1.0));
+
+			DTDparams = initDTDrawingParameters(
+				delTri,
+				window,
+				linesPoints,
+				pointsDraw,
+				activePointsDraw,
+				linesDraw,
+				bounds,
+				FAST,
+				sleep
+			);
+
+			triangulateDTIllustrated(DTDparams);
+
+			freeDTDrawingParameters(DTDparams);
+
+			bov_points_delete(activePointsDraw);
+
+			ILLUSTRATE = 0;
+		}
+
+		// 1.A If key bindings required an update in the drawing
+		if (REQUIRE_UPDATE) {
+			// Recompute triangulation
+			triangulateDT(delTri);
+			getInfoText(delTri, info_text_char);
+
+			getPointsBoudingBox(delTri->points, delTri->n_points, bounds);
+
+			//printf("bounds = (%f, %f) (%f, %f)\n", bounds[0][0], bounds[0][1], bounds[1][0], bounds[1][1]);
+
+			if (delTri->success) {
+
+				// Free old lines
+				if (linesPoints != NULL) free(linesPoints);
+
+				// Get new lines
+				n_lines = getDelaunayTriangulationNumberOfLines(delTri);
+				linesPoints = malloc(sizeof(linesPoints[0]) * 2 * n_lines);
+				getDelaunayTriangulationLines(delTri, linesPoints, n_lines);
+
+				// Update lines
+				bov_points_update(linesDraw, linesPoints, 2 * n_lines);
+
+				if (VORONOI) {
+					// Free old data
+					if (voronoiCenters != NULL) free(voronoiCenters);
+					if (voronoiNeighbors != NULL) free(voronoiNeighbors);
+					if (voronoiLines != NULL) free(voronoiLines);
+
+
+					// Get new Voronoi centers and lines
+					n_triangles = getNumberOfTriangles(delTri);
+
+					voronoiCenters = malloc(sizeof(voronoiCenters[0]) * n_triangles);
+					voronoiNeighbors = malloc(sizeof(voronoiNeighbors[0]) * n_triangles);
+
+					getVoronoiCentersAndNeighbors(delTri,
+												  voronoiCenters,
+											      voronoiNeighbors,
+											      n_triangles);
+
+					// Update Voronoi centers
+					bov_points_update(voronoiCentersDraw, voronoiCenters, n_triangles);
+
+					voronoiLines = malloc(sizeof(voronoiLines[0]) * 3 * 2 * n_triangles);
+
+					getVoronoiLines(delTri,
+									voronoiCenters,
+									voronoiNeighbors,
+									voronoiLines,
+									n_triangles);
+
+					bov_points_update(voronoiLinesDraw, voronoiLines, 3 * 2 * n_triangles);
+
+
+				}
+			}
+
+			// Update new points
+			updatePointsDraw(delTri, pointsDraw);
+
+			// Draws a red point where the mouse was when key was pressed
+			bov_points_update(mouseDraw, mousePoint, 1);
+			bov_points_set_color(mouseDraw, (GLfloat[4]) {1.0, 0.0, 0.0, 1.0});
+			bov_points_set_width(mouseDraw, MOUSE_POINTS_WIDTH);
+
+			GLsizei n_triangles = getNumberOfTriangles(delTri);
+
+			REQUIRE_UPDATE = 0;
+		}
+		// 1.B If no update required, a smooth fading is applied to the red point
+		else {
+			bov_points_param_t param = bov_points_get_param(mouseDraw);
+			param.fillColor[3] *= 0.95;
+			param.width -= (param.width - BASIC_POINTS_WIDTH) / 10;
+			bov_points_set_param(mouseDraw, param);
+		}
+
+		// 2. Drawing
+		if (delTri->success) {
+			if (FAST) {
+				if (SHOW_LINES) bov_fast_lines_draw(window, linesDraw, 0, BOV_TILL_END);
+				if (VORONOI) {
+					bov_fast_lines_draw(window, voronoiLinesDraw, 0, BOV_TILL_END);
+					bov_fast_points_draw(window, voronoiCentersDraw, 0, BOV_TILL_END);
+				}
+			}
+			else {
+				if (SHOW_LINES) bov_lines_draw(window, linesDraw, 0, BOV_TILL_END);
+				if (VORONOI) {
+					bov_lines_draw(window, voronoiLinesDraw, 0, BOV_TILL_END);
+					bov_points_draw(window, voronoiCentersDraw, 0, BOV_TILL_END);
+				}
+			}
+		}
+		if (FAST) {
+			if (SHOW_POINTS) bov_fast_points_draw(window, pointsDraw, 0, BOV_TILL_END);
+			bov_fast_points_draw(window, mouseDraw, 0, 1);
+		}
+		else {
+			if (SHOW_POINTS) bov_points_draw(window, pointsDraw, 0, BOV_TILL_END);
+			bov_points_draw(window, mouseDraw, 0, 1);
+		}
+
+		// 3. Adjust text place and boldness
+
+		double wtime = bov_window_get_time(window);
+
+		text_parameters.pos[1] = bov_window_get_yres(window) - 30 ;
+		text_parameters.fillColor[0] = 0.35 * sin(2 * wtime) + 0.35;
+		bov_text_set_param(text, text_parameters);
+
+		bov_text_set_boldness(text, 0.3 * sin(2 * wtime) + 0.3);
+
+		if (!HIDE_TEXT) {
+
+			bov_text_update(info_text, info_text_char);
+
+			bov_text_draw(window, text);
+			bov_text_draw(window, info_text);
+		}
+
+		// 4. Update windows
+		bov_window_update(window);
+	}
+
+	// Free all memory allocated
+	bov_text_delete(text);
+	bov_text_delete(info_text);
+	bov_text_delete(rules);
+	bov_points_delete(pointsDraw);
+	bov_points_delete(linesDraw);
+	bov_points_delete(mouseDraw);
+	bov_points_delete(voronoiCentersDraw);
+	bov_points_delete(voronoiLinesDraw);
+
+	if (linesPoints != NULL) free(linesPoints);
+	if (voronoiCenters != NULL) free(voronoiCenters);
+	if (voronoiNeighbors != NULL) free(voronoiNeighbors);
+	if (voronoiLines != NULL) free(voronoiLines);
+
+	if (file_out != NULL) fclose(file_out);
+}
+
+/*
+ * Re-Draws the DelaunayTriangulation points and lines.
+ *
+ * delTri:		the DelaunayTriangulation structure
+ * window:		the window
+ * linesPoints:	the preallocated array that will all the lines points, be sure that it contains enough space for all the lines!
+ * pointsDraw:	the structure used to draw the points
+ * activePointsDraw:	the structure used to draw the active points
+ * linesDraw:	the structure used to draw the lines
+ * FAST:		if 1, will use fast drawing
+ * sleep:		the sleep time in microseconds after calling the function
+ * bounds:		the bounding box of the points
+ *
+ * returns:		a new DTDrawingParameters structure
+ */
+DTDrawingParameters* initDTDrawingParameters(DelaunayTriangulation *delTri,
+											 bov_window_t *window,
+						 					 GLfloat linesPoints[][2],
+						 					 bov_points_t *pointsDraw,
+											 bov_points_t *activePointsDraw,
+											 bov_points_t *linesDraw,
+											 DTfloat bounds[][2],
+						 					 int FAST, int sleep) {
+
+	DTDrawingParameters *DTDparams = malloc(sizeof(DTDrawingParameters));
+	DTDparams->delTri = delTri;
+	DTDparams->window = window;
+	DTDparams->linesPoints = linesPoints;
+	DTDparams->pointsDraw = pointsDraw;
+	DTDparams->activePointsDraw = activePointsDraw;
+	DTDparams->linesDraw = linesDraw;
+	DTDparams->FAST = FAST;
+	DTDparams->sleep = sleep;
+	DTDparams->draw_circle = 1;
+
+	GLfloat dy = bounds[1][1] - bounds[0][1];
+
+	DTDparams->y_min = bounds[0][1] - 0.25 * dy;
+	DTDparams->y_max = bounds[1][1] + 0.25 * dy;
+
+	DTDparams->n_divides = 0;
+	DTDparams->n_divides_max = delTri->n_points >> 1;
+
+	DTDparams->divideLinesPoints = malloc(sizeof(DTDparams->divideLinesPoints[0]) * DTDparams->n_divides_max * 2);
+	DTDparams->divideLinesDraw = bov_points_new(DTDparams->divideLinesPoints, DTDparams->n_divides_max * 2, GL_STATIC_DRAW);
+	DTDparams->divideLinesMask = calloc(DTDparams->n_divides_max, sizeof(char));
+
+	bov_points_set_color(DTDparams->divideLinesDraw, DIVIDE_LINES_COLOR);
+	bov_points_set_width(DTDparams->divideLinesDraw, DIVIDE_LINES_WIDTH);
+
+	GLfloat dtheta = 2 * M_PI / (GLfloat) N_POINTS;
+	GLfloat theta = 0.0;
+
+	for (GLsizei i = 0; i < N_POINTS; i++) {
+		DTDparams->cos_[i] = cos(theta);
+		DTDparams->sin_[i] = sin(theta);
+
+		theta += dtheta;
+	}
+
+	DTDparams->searchPointsDraw = updatePointsDraw(DTDparams->delTri, NULL);
+	DTDparams->circlePointsDraw = bov_points_new(DTDparams->circ, N_POINTS, GL_STATIC_DRAW);
+	DTDparams->searchPointsOrder = bov_order_new(DTDparams->searchPoints, 3, GL_STATIC_DRAW);
+
+	bov_points_set_color(DTDparams->searchPointsDraw, SEARCHED_POINTS_COLOR);
+	bov_points_set_width(DTDparams->searchPointsDraw, SEARCHED_POINTS_WIDTH);
+	bov_points_set_color(DTDparams->circlePointsDraw, CIRCLE_LINES_COLOR);
+	bov_points_set_width(DTDparams->circlePointsDraw, CIRCLE_LINES_WIDTH);
+
+	return DTDparams;
+}
+
+/*
+ * Sets the new triplet of points to be the triangle from which the
+ * cicurmcicle will be computed.
+ *
+ * DTDparams:	the DTDrawingParameters structure
+ * i_a,b,c:		the point indices
+ */
+void setSearchPoints(DTDrawingParameters *DTDparams,
+					 GLsizei i_a, GLsizei i_b ,GLsizei i_c) {
+
+	DTDparams->searchPoints[0] = i_a;
+	DTDparams->searchPoints[1] = i_b;
+	DTDparams->searchPoints[2] = i_c;
+
+	bov_order_update(DTDparams->searchPointsOrder, DTDparams->searchPoints, 3);
+
+	GLfloat radius, center[2];
+	radius = circleCenter(DTDparams->delTri, i_a, i_b, i_c, center);
+
+	for (GLsizei i = 0; i < N_POINTS; i++) {
+		DTDparams->circ[i][0] = center[0] + radius * DTDparams->cos_[i];
+		DTDparams->circ[i][1] = center[1] + radius * DTDparams->sin_[i];
+	}
+
+	bov_points_update(DTDparams->circlePointsDraw, DTDparams->circ, N_POINTS);
+
+}
+
+/*
+ * Adds a dividing line at pivot point.
+ *
+ * DTDparams:	the DTDrawingParameters structure
+ * pivot:		the pivot point (start of right half)
+ */
+GLsizei addDivideLine(DTDrawingParameters *DTDparams, GLsizei pivot) {
+	if (DTDparams->n_divides == DTDparams->n_divides_max) {
+		printf("ERROR: Not enough space was allocated for divide lines\n");
+		exit(EXIT_FAILURE);
+	}
+
+	GLsizei divide_index = DTDparams->n_divides;
+
+	DTDparams->divideLinesMask[divide_index] = 1;
+
+	GLfloat x_mean = 0.5 * (DTDparams->delTri->points[pivot - 1][0] + DTDparams->delTri->points[pivot][0]);
+
+	DTDparams->divideLinesPoints[2 * divide_index    ][0] = x_mean;
+	DTDparams->divideLinesPoints[2 * divide_index    ][1] = DTDparams->y_min;
+	DTDparams->divideLinesPoints[2 * divide_index + 1][0] = x_mean;
+	DTDparams->divideLinesPoints[2 * divide_index + 1][1] = DTDparams->y_max;
+
+	DTDparams->n_divides++;
+
+	bov_points_update(DTDparams->divideLinesDraw, DTDparams->divideLinesPoints, 2 * DTDparams->n_divides);
+
+	return divide_index;
+}
+
+void deleteDivideLine(DTDrawingParameters *DTDparams, GLsizei index) {
+	DTDparams->divideLinesMask[index] = 0;
+}
+
+/*
+ * Frees a DTDrawingParameters structure and everything it has allocated.
+ *
+ * DTDparams:	the DTDrawingParameters structure
+ */
+void freeDTDrawingParameters(DTDrawingParameters *DTDparams) {
+	if (DTDparams != NULL) {
+		if (DTDparams->divideLinesPoints != NULL) free(DTDparams->divideLinesPoints);
+		if (DTDparams->divideLinesDraw != NULL) bov_points_delete(DTDparams->divideLinesDraw);
+		if (DTDparams->divideLinesMask != NULL) free(DTDparams->divideLinesMask);
+		if (DTDparams->searchPointsDraw != NULL) bov_points_delete(DTDparams->searchPointsDraw);
+		if (DTDparams->circlePointsDraw != NULL) bov_points_delete(DTDparams->circlePointsDraw);
+		if (DTDparams->searchPointsOrder != NULL) bov_order_delete(DTDparams->searchPointsOrder);
+		free(DTDparams);
+	}
+}
+
+/*
+ * Re-Draws the DelaunayTriangulation points and lines.
+ *
+ * DTDparams:	the DTDrawingParameters structure
+ * start:		the start index of the slice
+ * end:			the (excluded) end index of the slice
+ */
+void reDrawTriangulation(DTDrawingParameters *DTDparams,
+					 	 int start, int end) {
+
+	if (bov_window_should_close(DTDparams->window)) return;
+
+	// Get new lines
+	GLsizei n_lines = getDelaunayTriangulationNumberOfLines(DTDparams->delTri);
+
+
+	getDelaunayTriangulationLines(DTDparams->delTri, DTDparams->linesPoints, n_lines);
+
+	// Update lines
+	bov_points_update(DTDparams->linesDraw, DTDparams->linesPoints, 2 * n_lines);
+
+	if (DTDparams->FAST) {
+		bov_fast_lines_draw(DTDparams->window, DTDparams->linesDraw, 0, BOV_TILL_END);
+		bov_fast_points_draw(DTDparams->window, DTDparams->pointsDraw, 0, BOV_TILL_END);
+		bov_fast_points_draw(DTDparams->window, DTDparams->activePointsDraw, start, end);
+
+		for (GLsizei i = 0; i < DTDparams->n_divides; i++) {
+			if (DTDparams->divideLinesMask[i]) {
+				bov_fast_lines_draw(DTDparams->window, DTDparams->divideLinesDraw, 2 * i, 2 * i + 2);
+			}
+		}
+
+		if (DTDparams->draw_circle) {
+				bov_fast_line_loop_draw(DTDparams->window, DTDparams->circlePointsDraw, 0, BOV_TILL_END);
+				bov_fast_points_draw_with_order(DTDparams->window, DTDparams->searchPointsDraw, DTDparams->searchPointsOrder, 0, BOV_TILL_END);
+		}
+	}
+	else {
+		bov_lines_draw(DTDparams->window, DTDparams->linesDraw, 0, BOV_TILL_END);
+		bov_points_draw(DTDparams->window, DTDparams->pointsDraw, 0, BOV_TILL_END);
+		bov_points_draw(DTDparams->window, DTDparams->activePointsDraw, start, end);
+
+		for (GLsizei i = 0; i < DTDparams->n_divides; i++) {
+			if (DTDparams->divideLinesMask[i]) {
+				bov_lines_draw(DTDparams->window, DTDparams->divideLinesDraw, 2 * i, 2 * i + 2);
+			}
+		}
+
+		if (DTDparams->draw_circle) {
+				bov_line_loop_draw(DTDparams->window, DTDparams->circlePointsDraw, 0, BOV_TILL_END);
+				bov_points_draw_with_order(DTDparams->window, DTDparams->searchPointsDraw, DTDparams->searchPointsOrder, 0, BOV_TILL_END);
+		}
+	}
+
+	bov_window_update(DTDparams->window);
+	usleep(DTDparams->sleep);
+}
+
+/*
+ * Triangulates a set of points using the DelaunayTriangulation.
+ * This function should be the main function which will all the other sub-functions.
+ *
+ * DTDparams:	the DTDrawingParameters structure
+ *
+ * returns:		1 if the triangulation was computed, 0 otherwise (not enough memory for edges)
+ */
+int triangulateDTIllustrated(DTDrawingParameters *DTDparams) {
+	if (DTDparams->delTri->success) {
+		return 1;
+	}
+	compactPoints(DTDparams->delTri);
+	if (DTDparams->delTri->n_points < 2) {
+		return 0;
+	}
+
+	// Sort points by x coordinates then by y coordinate.
+	if (!DTDparams->delTri->sorted) {
+		sortPoints(DTDparams->delTri->points, DTDparams->delTri->n_points, 0);
+		DTDparams->delTri->sorted = 1;
+		DTDparams->delTri->arranged = 0;
+		DTDparams->delTri->grid_nx = DTDparams->delTri->grid_ny = 0;
+	}
+
+	DTDparams->draw_circle = 0;
+	reDrawTriangulation(DTDparams, 0, 0);
+	DTDparams->draw_circle = 1;
+
+	/// Starts the triangulation using a divide and conquer approach.
+	EdgeRef l, r;
+	if (!triangulateIllustrated(DTDparams->delTri, 0, DTDparams->delTri->n_points, &l, &r, DTDparams)) {
+		printf("ERROR: Triangulation aborted, edges could not be allocated\n");
+		resetDelaunayTriangulation(DTDparams->delTri);
+		return 0;
+	}
+	DTDparams->delTri->hint = l;
+	DTDparams->delTri->success = 1;
+	return 1;
+}
+
+/*
+ * Recursive function used by the triangulateDT function in order to solve
+ * the triangulation problem using a divide and conquer approach.
+ *
+ * delTri: 		the DelaunayTriangulation structure
+ * start:		the start index of the slice
+ * end:			the (excluded) end index of the slice
+ * el:			an Edge structure pointer for the left edge
+ * er:			an Edge structure pointer for the right edge
+ * DTDparams:	the DTDrawingParameters structure
+ *
+ * returns:		1 on success, 0 if an edge could not be allocated
+ */
+int triangulateIllustrated(DelaunayTriangulation *delTri, GLsizei start, GLsizei end, EdgeRef *el, EdgeRef *er,
+						    DTDrawingParameters *DTDparams) {
+	GLsizei n = end - start;
+	if (n == 2) {
+		// Creates an edge connecting the two points (start), (start + 1)
+		EdgeRef e = addEdge(delTri, start, start + 1);
+		if (e == EDGE_NULL) return 0;
+		*el = e;
+		*er = SYM(delTri, e);
+		DTDparams->draw_circle = 0;
+		reDrawTriangulation(DTDparams, start, end);
+		DTDparams->draw_circle = 1;
+		return 1;
+	}
+	else if (n == 3) {
+		EdgeRef a, b, c;
+
+		// Creates two edges
+		// - a, connecting (start), 	(start + 1)
+		// - b, connecting (start + 1), (start + 2)
+		a = addEdge(delTri, start, 		start + 1);
+		b = addEdge(delTri, start + 1, 	start + 2);
+		if ((a == EDGE_NULL) || (b == EDGE_NULL)) return 0;
+		spliceEdges(delTri, SYM(delTri, a), b);
+
+		int cmp = pointCompareEdge(delTri, start + 2, a);
+
+		setSearchPoints(DTDparams, ORIG(delTri, a), DEST(delTri, a), DEST(delTri, b));
+
+		// Now will close the triangle formed by the three points
+		if (cmp == 1) {
+			c = connectEdges(delTri, b, a);
+			if (c == EDGE_NULL) return 0;
+			*el = a;
+			*er = SYM(delTri, b);
+			reDrawTriangulation(DTDparams, start, end);
+			return 1;
+		}
+		else if (cmp == -1) {
+			c = connectEdges(delTri, b, a);
+			if (c == EDGE_NULL) return 0;
+			*el = SYM(delTri, c);
+			*er = c;
+			reDrawTriangulation(DTDparams, start, end);
+			return 1;
+		}
+		else {
+			*el = a;
+			*er = SYM(delTri, b);
+			reDrawTriangulation(DTDparams, start, end);
+			return 1;
+		}
+	}
+	else {
+		// Recusively calls this function on half the points
+		GLsizei m = (n + 1) / 2;
+		EdgeRef ldo, ldi, rdi, rdo;
+
+		GLsizei divide_index = addDivideLine(DTDparams, start + m);
+		DTDparams->draw_circle = 0;
+		reDrawTriangulation(DTDparams, start, end);
+		DTDparams->draw_circle = 1;
+
+		if (!triangulateIllustrated(delTri, start, 		start + m, 	&ldo, &ldi, DTDparams)) return 0;
+		if (!triangulateIllustrated(delTri, start + m, 	end, 		&rdi, &rdo, DTDparams)) return 0;
+		deleteDivideLine(DTDparams, divide_index);
+
+		// Computes the upper common tangent of left and right edges
+		while (1) {
+			setSearchPoints(DTDparams, ORIG(delTri, rdi), DEST(delTri, rdi), DEST(delTri, ldi));
+			if 		(pointCompareEdge(delTri, ORIG(delTri, rdi), ldi) ==  1) {
+				ldi = ONEXT(delTri, SYM(delTri, ldi));
+				reDrawTriangulation(DTDparams, start, end);
+			}
+			else if (pointCompareEdge(delTri, ORIG(delTri, ldi), rdi) == -1) {
+				rdi = OPREV(delTri, SYM(delTri, rdi));
+				reDrawTriangulation(DTDparams, start, end);
+			}
+			else {
+				break;
+			}
+		}
+
+		EdgeRef base;
+		DTDparams->draw_circle = 0;
+
+		// Creates an edge between rdi.orig and ldi.orig
+		base = connectEdges(delTri, SYM(delTri, ldi), rdi);
+		if (base == EDGE_NULL) return 0;
+		reDrawTriangulation(DTDparams, start, end);
+
+		// Ajdusts ldo and rdo
+		if (ORIG(delTri, ldi) == ORIG(delTri, ldo)) {
+			ldo = base;
+			reDrawTriangulation(DTDparams, start, end);
+		}
+		if (ORIG(delTri, rdi) == ORIG(delTri, rdo)) {
+			rdo = SYM(delTri, base);
+			reDrawTriangulation(DTDparams, start, end);
+		}
+		DTDparams->draw_circle = 1;
+
+		EdgeRef lcand, rcand, tmp;
+		int v_rcand, v_lcand;
+
+		// We merge both parts
+		while (1) {
+			// Locates the first right and left points to be encountered
+			// by the diving bubble
+
+			rcand = ONEXT(delTri, SYM(delTri, base));
+			lcand = OPREV(delTri, base);
+
+			v_rcand = (pointCompareEdge(delTri, DEST(delTri, rcand), base) == 1);
+			v_lcand = (pointCompareEdge(delTri, DEST(delTri, lcand), base) == 1);
+
+			if (!(v_rcand || v_lcand)) {
+				// Merge is done
+				break;
+			}
+			// Deletes right edges that fail the circle test
+			if (v_rcand) {
+				while ((pointCompareEdge(delTri, DEST(delTri, ONEXT(delTri, rcand)), base) == 1) &&
+					   (pointInCircle(delTri, DEST(delTri, ONEXT(delTri, rcand)), DEST(delTri, base), ORIG(delTri, base), DEST(delTri, rcand)))
+				   )
+					   {
+						   tmp = ONEXT(delTri, rcand);
+						   deleteEdge(delTri, rcand);
+						   rcand = tmp;
+						   setSearchPoints(DTDparams, DEST(delTri, base), ORIG(delTri, base), DEST(delTri, rcand));
+						   reDrawTriangulation(DTDparams, start, end);
+					   }
+			}
+			// Deletes left edges that fail the circle test
+			if (v_lcand) {
+				while ((pointCompareEdge(delTri, DEST(delTri, OPREV(delTri, lcand)), base) == 1) &&
+					   (pointInCircle(delTri, DEST(delTri, OPREV(delTri, lcand)), DEST(delTri, base), ORIG(delTri, base), DEST(delTri, lcand)))
+				   )
+					   {
+						   tmp = OPREV(delTri, lcand);
+						   deleteEdge(delTri, lcand);
+						   lcand = tmp;
+						   setSearchPoints(DTDparams, DEST(delTri, base), ORIG(delTri, base), DEST(delTri, lcand));
+						   reDrawTriangulation(DTDparams, start, end);
+					   }
+			}
+
+			if ((!v_rcand) ||
+				(v_rcand && pointInCircle(delTri, DEST(delTri, lcand), DEST(delTri, rcand), ORIG(delTri, rcand), ORIG(delTri, lcand)))
+			) {
+
+				tmp = connectEdges(delTri, lcand, SYM(delTri, base));
+				if (tmp == EDGE_NULL) return 0;
+				base = tmp;
+				setSearchPoints(DTDparams, DEST(delTri, rcand), ORIG(delTri, rcand), ORIG(delTri, lcand));
+				reDrawTriangulation(DTDparams, start, end);
+			}
+			else {
+				tmp = connectEdges(delTri, SYM(delTri, base), SYM(delTri, rcand));
+				if (tmp == EDGE_NULL) return 0;
+				base = tmp;
+				setSearchPoints(DTDparams, DEST(delTri, rcand), ORIG(delTri, rcand), ORIG(delTri, lcand));
+				reDrawTriangulation(DTDparams, start, end);
+			}
+		}
+		DTDparams->draw_circle = 0;
+		reDrawTriangulation(DTDparams, start, end);
+		DTDparams->draw_circle = 1;
+		*el = ldo;
+		*er = rdo;
+		return 1;
+	}
+}
+
+////////////////////////////
+// End: Drawing functions //
+////////////////////////////